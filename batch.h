@@ -0,0 +1,72 @@
+﻿/*
+ * File: batch.h
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Defines `DesignBatch`, a column‐per‐field ("structure of arrays") container for many designs at once.
+ *   - `in[0..6]`  : one column per input (D, S, B, L, A, T, W), same order as Maths::mathInput[1..7]
+ *   - `out[0..8]` : one column per output (WS ... CLL), same order as Maths::mathOutput[1..9]
+ *   - `mask`      : per‐row error bits, filled in by Validation::validate() (empty until then)
+ *   - `addDesign()`: append one row of inputs (outputs are left at 0 until evaluate() runs)
+ *   - `evaluate()` : run Maths::formulas() on every row
+ *
+ * Developer Notes:
+ *  - Keeping each field in its own column means loops over a single field walk contiguous memory,
+ *    which is what lets the compiler vectorize them.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "maths.h"
+
+struct DesignBatch {
+    std::vector<double> in[Maths::inputCount];   // input columns
+    std::vector<double> out[Maths::outputCount]; // output columns
+    std::vector<std::uint32_t> mask;             // error bits per row (see validation.h)
+
+    // Number of designs (rows) in the batch.
+    std::size_t size() const {
+        return in[0].size();
+    }
+
+    // Resize every column to rows designs.
+    void resize(std::size_t rows) {
+        for (auto& column : in) column.resize(rows);
+        for (auto& column : out) column.resize(rows);
+        mask.clear();
+    }
+
+    // Append one design; inputs points at 7 values in mathInput order.
+    void addDesign(const double* inputs) {
+        for (int i = 0; i < Maths::inputCount; i++) in[i].push_back(inputs[i]);
+        for (auto& column : out) column.push_back(0.0);
+    }
+
+    // Copy the current mathInput values of maths in as a new row.
+    void addDesign(Maths& maths) {
+        double inputs[Maths::inputCount];
+        for (int i = 0; i < Maths::inputCount; i++) inputs[i] = maths.mathInput[i + 1].input;
+        addDesign(inputs);
+    }
+
+    // Fill every output column from the input columns.
+    void evaluate() {
+        const std::size_t rows = size();
+        for (std::size_t r = 0; r < rows; r++) {
+            double rowIn[Maths::inputCount];
+            double rowOut[Maths::outputCount];
+            for (int i = 0; i < Maths::inputCount; i++) rowIn[i] = in[i][r];
+            Maths::formulas(rowIn, rowOut);
+            for (int o = 0; o < Maths::outputCount; o++) out[o][r] = rowOut[o];
+        }
+    }
+};
+
+#endif // BATCH_H
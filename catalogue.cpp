@@ -0,0 +1,427 @@
+﻿/*
+ * File: catalogue.cpp
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Implements `Catalogue`.
+ *   Index file layout (all little‐endian, written and read as raw structs):
+ *     Header | Node × count (tree order) | name offsets × (count + 1) | name characters
+ *   - build(): parse, normalize, arrange into an implicit k‐d tree with nth_element, write the file.
+ *   - open(): mmap the file (or read it in whole where mmap isn't available) and point into it.
+ *   - nearest()/search(): depth‐first k‐d tree search. Each half's distance from the query is tracked as the
+ *                distance to its bounding box (updated one input at a time), and halves farther than the
+ *                current k‐th best are skipped.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "catalogue.h"
+#include "sweep.h"
+#include "maths.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+struct Catalogue::Header {
+    char magic[8];                      // "VGCKDT1"
+    std::uint64_t count;                // entries
+    double mean[Maths::inputCount];     // per input, used to normalize queries
+    double scale[Maths::inputCount];    // 1 / standard deviation per input
+    std::uint64_t nodesOffset;
+    std::uint64_t nameOffsetsOffset;
+    std::uint64_t namesOffset;
+    std::uint64_t fileSize;
+};
+
+struct Catalogue::Node {
+    float x[Maths::inputCount];         // normalized inputs
+    std::uint32_t line;                 // line number in the source file
+};
+
+namespace {
+    const char catalogueMagic[8] = { 'V', 'G', 'C', 'K', 'D', 'T', '1', '\0' };
+
+    struct Entry {
+        std::string name;
+        double x[Maths::inputCount];
+        std::uint32_t line;
+    };
+
+    // Arrange order[lo, hi) so the median on `depth % 7` is in the middle, then do the same for both halves.
+    void arrange(std::vector<std::uint32_t>& order, const std::vector<std::vector<float>>& z,
+        std::size_t lo, std::size_t hi, int depth) {
+        if (hi - lo <= 1) return;
+        std::size_t mid = lo + (hi - lo) / 2;
+        int dim = depth % Maths::inputCount;
+        std::nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi,
+            [&](std::uint32_t a, std::uint32_t b) { return z[a][dim] < z[b][dim]; });
+        arrange(order, z, lo, mid, depth + 1);
+        arrange(order, z, mid + 1, hi, depth + 1);
+    }
+}
+
+Catalogue::~Catalogue() {
+    close();
+}
+
+bool Catalogue::build(const std::string& source, const std::string& index, std::ostream& report) {
+    std::ifstream inFile(source);
+    if (!inFile.is_open()) {
+        report << "No catalogue found at " << source << ".\n";
+        return false;
+    }
+
+    // Each line: Name, D, S, B, L, A, T, W. The last 7 fields are the numbers, everything before is the name.
+    std::vector<Entry> entries;
+    std::string line;
+    std::uint32_t lineNumber = 0;
+    std::uint64_t skipped = 0;
+    while (std::getline(inFile, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ',')) fields.push_back(field);
+        if (fields.size() < Maths::inputCount + 1) {
+            skipped++;
+            continue;
+        }
+
+        Entry entry;
+        entry.line = lineNumber;
+        bool ok = true;
+        std::size_t first = fields.size() - Maths::inputCount;
+        for (int i = 0; i < Maths::inputCount && ok; i++) {
+            try {
+                entry.x[i] = std::stod(fields[first + i]);
+            }
+            catch (...) {
+                ok = false;
+            }
+        }
+        if (!ok) {
+            skipped++;
+            continue;
+        }
+        for (std::size_t f = 0; f < first; f++) entry.name += (f > 0 ? "," : "") + fields[f];
+        std::size_t start = entry.name.find_first_not_of(" \t");
+        entry.name = (start == std::string::npos) ? "" : entry.name.substr(start);
+        entries.push_back(entry);
+    }
+    if (entries.empty()) {
+        report << "No usable lines in " << source << ".\n";
+        return false;
+    }
+
+    // Normalize each input by the catalogue's own mean and standard deviation.
+    Header header{};
+    std::memcpy(header.magic, catalogueMagic, sizeof(catalogueMagic));
+    header.count = entries.size();
+    for (int i = 0; i < Maths::inputCount; i++) {
+        double sum = 0.0;
+        double sumSquares = 0.0;
+        for (const Entry& e : entries) {
+            sum += e.x[i];
+            sumSquares += e.x[i] * e.x[i];
+        }
+        double mean = sum / entries.size();
+        double variance = sumSquares / entries.size() - mean * mean;
+        header.mean[i] = mean;
+        header.scale[i] = variance > 0.0 ? 1.0 / std::sqrt(variance) : 1.0;
+    }
+    std::vector<std::vector<float>> z(entries.size(), std::vector<float>(Maths::inputCount));
+    for (std::size_t e = 0; e < entries.size(); e++) {
+        for (int i = 0; i < Maths::inputCount; i++) {
+            z[e][i] = static_cast<float>((entries[e].x[i] - header.mean[i]) * header.scale[i]);
+        }
+    }
+
+    std::vector<std::uint32_t> order(entries.size());
+    for (std::size_t e = 0; e < order.size(); e++) order[e] = static_cast<std::uint32_t>(e);
+    arrange(order, z, 0, order.size(), 0);
+
+    // Names are stored in tree order too, so a node's position is all a match needs.
+    std::vector<Node> tree(entries.size());
+    std::vector<std::uint64_t> nameOffsets(entries.size() + 1, 0);
+    std::string nameChars;
+    for (std::size_t n = 0; n < order.size(); n++) {
+        const std::uint32_t e = order[n];
+        for (int i = 0; i < Maths::inputCount; i++) tree[n].x[i] = z[e][i];
+        tree[n].line = entries[e].line;
+        nameOffsets[n] = nameChars.size();
+        nameChars += entries[e].name;
+    }
+    nameOffsets[entries.size()] = nameChars.size();
+
+    header.nodesOffset = sizeof(Header);
+    header.nameOffsetsOffset = header.nodesOffset + tree.size() * sizeof(Node);
+    header.namesOffset = header.nameOffsetsOffset + nameOffsets.size() * sizeof(std::uint64_t);
+    header.fileSize = header.namesOffset + nameChars.size();
+
+    std::ofstream outFile(index, std::ios::binary);
+    if (!outFile.is_open()) {
+        report << "Error: couldn't open " << index << " for writing.\n";
+        return false;
+    }
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outFile.write(reinterpret_cast<const char*>(tree.data()), static_cast<std::streamsize>(tree.size() * sizeof(Node)));
+    outFile.write(reinterpret_cast<const char*>(nameOffsets.data()),
+        static_cast<std::streamsize>(nameOffsets.size() * sizeof(std::uint64_t)));
+    outFile.write(nameChars.data(), static_cast<std::streamsize>(nameChars.size()));
+
+    report << "Catalogue built: " << entries.size() << " locomotives";
+    if (skipped > 0) report << " (" << skipped << " lines skipped)";
+    report << ".\n";
+    return true;
+}
+
+bool Catalogue::attach(const char* data, std::size_t bytes) {
+    if (bytes < sizeof(Header)) return false;
+    const Header* h = reinterpret_cast<const Header*>(data);
+    if (std::memcmp(h->magic, catalogueMagic, sizeof(catalogueMagic)) != 0 || h->fileSize != bytes || h->count == 0) {
+        return false;
+    }
+    header = h;
+    nodes = reinterpret_cast<const Node*>(data + h->nodesOffset);
+    nameOffsets = reinterpret_cast<const std::uint64_t*>(data + h->nameOffsetsOffset);
+    names = data + h->namesOffset;
+    return true;
+}
+
+#ifdef __linux__
+bool Catalogue::open(const std::string& index) {
+    close();
+    int fd = ::open(index.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    mappedBytes = static_cast<std::size_t>(info.st_size);
+    void* memory = mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        mappedBytes = 0;
+        return false;
+    }
+    mapped = memory;
+    if (!attach(static_cast<const char*>(memory), mappedBytes)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void Catalogue::close() {
+    if (mapped != nullptr) munmap(mapped, mappedBytes);
+    mapped = nullptr;
+    mappedBytes = 0;
+    loaded.clear();
+    header = nullptr;
+    nodes = nullptr;
+    nameOffsets = nullptr;
+    names = nullptr;
+}
+#else
+bool Catalogue::open(const std::string& index) {
+    close();
+    std::ifstream inFile(index, std::ios::binary | std::ios::ate);
+    if (!inFile.is_open()) return false;
+    loaded.resize(static_cast<std::size_t>(inFile.tellg()));
+    inFile.seekg(0);
+    inFile.read(loaded.data(), static_cast<std::streamsize>(loaded.size()));
+    if (!attach(loaded.data(), loaded.size())) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void Catalogue::close() {
+    loaded.clear();
+    header = nullptr;
+    nodes = nullptr;
+    nameOffsets = nullptr;
+    names = nullptr;
+}
+#endif
+
+std::uint64_t Catalogue::size() const {
+    return header != nullptr ? header->count : 0;
+}
+
+std::string Catalogue::name(std::uint32_t id) const {
+    return std::string(names + nameOffsets[id], names + nameOffsets[id + 1]);
+}
+
+void Catalogue::values(std::uint32_t id, double* inputs) const {
+    for (int i = 0; i < Maths::inputCount; i++) {
+        inputs[i] = nodes[id].x[i] / header->scale[i] + header->mean[i];
+    }
+}
+
+std::uint32_t Catalogue::line(std::uint32_t id) const {
+    return nodes[id].line;
+}
+
+void Catalogue::search(std::uint64_t lo, std::uint64_t hi, int depth, const float* query, double* offsets,
+    double boxDistance, int k, std::vector<CatalogueMatch>& best) const {
+    // best holds up to k matches sorted by squared distance; the last one is the bar a new match has to beat.
+    auto worst = [&]() {
+        return best.size() < static_cast<std::size_t>(k) ? HUGE_VAL : best.back().distance;
+    };
+    auto consider = [&](std::uint64_t n) {
+        double d = 0.0;
+        for (int i = 0; i < Maths::inputCount; i++) {
+            double diff = static_cast<double>(nodes[n].x[i]) - query[i];
+            d += diff * diff;
+        }
+        if (d < worst()) {
+            CatalogueMatch match{ static_cast<std::uint32_t>(n), d };
+            best.insert(std::upper_bound(best.begin(), best.end(), match,
+                [](const CatalogueMatch& a, const CatalogueMatch& b) { return a.distance < b.distance; }), match);
+            if (best.size() > static_cast<std::size_t>(k)) best.pop_back();
+        }
+    };
+
+    // Small ranges are cheaper to scan than to split further.
+    if (hi - lo <= 8) {
+        for (std::uint64_t n = lo; n < hi; n++) consider(n);
+        return;
+    }
+    std::uint64_t mid = lo + (hi - lo) / 2;
+    const Node& node = nodes[mid];
+    consider(mid);
+
+    int dim = depth % Maths::inputCount;
+    double gap = static_cast<double>(query[dim]) - node.x[dim];
+    if (gap < 0) {
+        search(lo, mid, depth + 1, query, offsets, boxDistance, k, best);
+    }
+    else {
+        search(mid + 1, hi, depth + 1, query, offsets, boxDistance, k, best);
+    }
+
+    // The far side is at least as far as its box: swap this input's offset for the gap to the splitting plane.
+    double oldOffset = offsets[dim];
+    double farDistance = boxDistance - oldOffset * oldOffset + gap * gap;
+    if (farDistance < worst()) {
+        offsets[dim] = gap;
+        if (gap < 0) {
+            search(mid + 1, hi, depth + 1, query, offsets, farDistance, k, best);
+        }
+        else {
+            search(lo, mid, depth + 1, query, offsets, farDistance, k, best);
+        }
+        offsets[dim] = oldOffset;
+    }
+}
+
+void Catalogue::nearest(const double* inputs, int k, std::vector<CatalogueMatch>& matches) const {
+    matches.clear();
+    if (!isOpen() || k <= 0) return;
+
+    float query[Maths::inputCount];
+    double offsets[Maths::inputCount] = {};
+    for (int i = 0; i < Maths::inputCount; i++) {
+        query[i] = static_cast<float>((inputs[i] - header->mean[i]) * header->scale[i]);
+    }
+
+    matches.reserve(static_cast<std::size_t>(k) + 1);
+    search(0, header->count, 0, query, offsets, 0.0, k, matches);
+    for (CatalogueMatch& match : matches) {
+        match.distance = std::sqrt(match.distance);
+    }
+}
+
+void Catalogue::bulkNearest(const DesignBatch& batch, int k, std::vector<CatalogueMatch>& matches, int threads) const {
+    const std::size_t rows = batch.size();
+    matches.assign(rows * static_cast<std::size_t>(k > 0 ? k : 0), CatalogueMatch{ noMatch, HUGE_VAL });
+    if (rows == 0 || k <= 0 || !isOpen()) return;
+
+    std::size_t threadCount = threads > 0 ? static_cast<std::size_t>(threads) : std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+    if (threadCount > rows) threadCount = rows;
+
+    // Each thread answers one contiguous block of rows. Queries only read the mapping, so nothing is shared‐written.
+    auto work = [&](std::size_t begin, std::size_t end) {
+        std::vector<CatalogueMatch> found;
+        for (std::size_t row = begin; row < end; row++) {
+            double inputs[Maths::inputCount];
+            for (int i = 0; i < Maths::inputCount; i++) inputs[i] = batch.in[i][row];
+            nearest(inputs, k, found);
+            std::copy(found.begin(), found.end(), matches.begin() + row * k);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < threadCount; t++) {
+        pool.emplace_back(work, rows * t / threadCount, rows * (t + 1) / threadCount);
+    }
+    work(0, rows / threadCount);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+bool Catalogue::nearestFile(const std::string& sweepPath, int k, const std::string& outPath,
+    std::ostream& report, int threads) const {
+    if (k > 0 && static_cast<std::uint64_t>(k) > size()) {
+        k = static_cast<int>(size());
+        report << "The catalogue only has " << k << " locomotives; finding " << k << " per design.\n";
+    }
+    if (k <= 0) {
+        report << "The catalogue is empty or not open.\n";
+        return false;
+    }
+    std::ifstream sweepFile(sweepPath, std::ios::binary);
+    if (!sweepFile.is_open()) {
+        report << "Error: couldn't open " << sweepPath << ".\n";
+        return false;
+    }
+    std::ofstream outFile(outPath, std::ios::binary);
+    if (!outFile.is_open()) {
+        report << "Error: couldn't open " << outPath << " for writing.\n";
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    DesignBatch batch;
+    std::vector<CatalogueMatch> matches;
+    std::vector<NearestRecord> records;
+    std::uint64_t design = 0;
+    std::size_t rows;
+    while ((rows = Sweep::readChunk(sweepFile, batch, 65536)) > 0) {
+        bulkNearest(batch, k, matches, threads);
+        records.resize(matches.size());
+        for (std::size_t m = 0; m < matches.size(); m++) {
+            records[m] = NearestRecord{ design + m / k, line(matches[m].id), matches[m].distance };
+        }
+        outFile.write(reinterpret_cast<const char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(NearestRecord)));
+        design += rows;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    report << "Designs: " << design << " x " << k << " nearest written to " << outPath << "\n"
+        << "Time: " << seconds << " s (" << (seconds > 0 ? design / seconds : 0.0) << " queries/s)\n";
+    return true;
+}
@@ -0,0 +1,108 @@
+﻿/*
+ * File: catalogue.h
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Declares `Catalogue`, a nearest‐neighbour index over the 7 inputs of known locomotives.
+ *   - `build()`       : read “inputs/catalogue.txt” (one locomotive per line: Name, D, S, B, L, A, T, W) and write
+ *                       the index file “inputs/catalogue.kdt”
+ *   - `open()`        : memory‐map the index file (no loading/parsing, so opening is instant at any size)
+ *   - `nearest()`     : the k closest catalogue entries to one design
+ *   - `bulkNearest()` : the same for every row of a DesignBatch, split across threads
+ *   - `nearestFile()` : the same for a whole sweep file, written to a file of NearestRecords
+ *
+ * Developer Notes:
+ *  - Distance is Euclidean after normalizing each input by the catalogue's mean and standard deviation, so
+ *    1" of Lead counts for a lot more than 1" of Drive Wheel Diameter.
+ *  - The k‐d tree is implicit: entries are stored so the median of every range sits in its middle, and the split
+ *    input cycles with depth. No child pointers are needed, so each entry is just 32 bytes.
+ */
+
+#ifndef CATALOGUE_H
+#define CATALOGUE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "maths.h"
+#include "batch.h"
+
+// One catalogue entry found by a query.
+struct CatalogueMatch {
+    std::uint32_t id = 0;    // entry number in the index, for name(), values() and line(); not meaningful elsewhere
+    double distance = 0.0;   // normalized distance (in standard deviations)
+};
+
+// One row of the file nearestFile() writes (k rows per design, closest first).
+struct NearestRecord {
+    std::uint64_t design;    // record number in the sweep file
+    std::uint64_t line;      // line of the locomotive in the catalogue source file (first line = 1)
+    double distance;
+};
+
+class Catalogue {
+public:
+    static constexpr const char* sourcePath = "inputs/catalogue.txt";
+    static constexpr const char* indexPath = "inputs/catalogue.kdt";
+
+    Catalogue() = default;
+    Catalogue(const Catalogue&) = delete;            // owns a memory mapping
+    Catalogue& operator=(const Catalogue&) = delete;
+    ~Catalogue();
+
+    // Parse source and write the index to index. Reports the number of entries (or what went wrong).
+    static bool build(const std::string& source, const std::string& index, std::ostream& report);
+
+    // Map an index file written by build(). Returns false if it is missing or not a catalogue index.
+    bool open(const std::string& index);
+    void close();
+    bool isOpen() const { return nodes != nullptr; }
+
+    // Slots bulkNearest() has no entry for (k larger than the catalogue) get this id and a distance of HUGE_VAL.
+    static constexpr std::uint32_t noMatch = 0xFFFFFFFF;
+
+    // Number of entries.
+    std::uint64_t size() const;
+
+    // Name of entry id, its 7 inputs (as stored, to float precision), and the source file line it came from.
+    std::string name(std::uint32_t id) const;
+    void values(std::uint32_t id, double* inputs) const;
+    std::uint32_t line(std::uint32_t id) const;
+
+    // The k entries closest to inputs[0..6], closest first.
+    void nearest(const double* inputs, int k, std::vector<CatalogueMatch>& matches) const;
+
+    // matches[row * k + j] = j‐th closest entry to batch row. threads = 0 uses every hardware thread.
+    void bulkNearest(const DesignBatch& batch, int k, std::vector<CatalogueMatch>& matches, int threads = 0) const;
+
+    // Query every record of a sweep file and write NearestRecords to outPath. k is capped at size().
+    bool nearestFile(const std::string& sweepPath, int k, const std::string& outPath,
+        std::ostream& report, int threads = 0) const;
+
+private:
+    struct Header;
+    struct Node;
+
+    const Header* header = nullptr;
+    const Node* nodes = nullptr;
+    const std::uint64_t* nameOffsets = nullptr;
+    const char* names = nullptr;
+
+    void* mapped = nullptr;        // mmap'd file (Linux)
+    std::size_t mappedBytes = 0;
+    std::vector<char> loaded;      // whole file read into memory (other platforms)
+
+    bool attach(const char* data, std::size_t bytes);
+
+    // k‐nearest search of tree range [lo, hi). offsets[i] = query's distance outside the range's box on input i,
+    // boxDistance = sum of their squares. best is kept sorted by squared distance.
+    void search(std::uint64_t lo, std::uint64_t hi, int depth, const float* query, double* offsets,
+        double boxDistance, int k, std::vector<CatalogueMatch>& best) const;
+};
+
+#endif // CATALOGUE_H
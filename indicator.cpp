@@ -0,0 +1,209 @@
+﻿/*
+ * File: indicator.cpp
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Implements `Indicator`:
+ *   - evaluate(): work out the valve events for the cutoff, walk the crank through one revolution summing p·dV,
+ *                 then convert to MEP, horsepower and steam use.
+ *   - evaluateBatch(): splits the design × cutoff grid into one contiguous block per thread.
+ *   - evaluateFile(): streams a sweep file through evaluateBatch() in chunks.
+ */
+
+#define _USE_MATH_DEFINES   // for M_PI
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "indicator.h"
+#include "sweep.h"
+#include "maths.h"
+
+namespace {
+    const double atmosphere = 14.7; // psi, gauge → absolute
+
+    // Specific volume (ft³/lb) of dry saturated steam at absolute pressure p (psia), Zeuner: p·v^1.0646 = 475.
+    double steamVolume(double p) {
+        return std::pow(475.0 / p, 1.0 / 1.0646);
+    }
+
+    // Piston position as a fraction of stroke at crank angle theta (0 = dead center at the start of the stroke).
+    double pistonFraction(double theta, double rodRatio) {
+        double crank = 1.0 - std::cos(theta);
+        if (rodRatio <= 1.0) {
+            return crank / 2.0;
+        }
+        double s = std::sin(theta);
+        return (crank + rodRatio - std::sqrt(rodRatio * rodRatio - s * s)) / 2.0;
+    }
+
+    // Crank angle in [0, π] at which the piston has covered fraction of its stroke: pistonFraction() solved by
+    // bisection, since with a finite rod there's no tidy inverse. It rises steadily over [0, π], so 60 halvings
+    // pin the angle down to double precision.
+    double crankAngleAt(double fraction, double rodRatio) {
+        double low = 0.0;
+        double high = M_PI;
+        for (int k = 0; k < 60; k++) {
+            double mid = (low + high) / 2.0;
+            if (pistonFraction(mid, rodRatio) < fraction) low = mid;
+            else high = mid;
+        }
+        return (low + high) / 2.0;
+    }
+}
+
+IndicatorResult Indicator::evaluate(const double* in, const double* out, double cutoff) const {
+    IndicatorResult result;
+    result.cutoff = cutoff;
+
+    const double stroke = in[1];
+    const double lead = in[3];
+    const double lap = in[4];
+    const double halfTravel = out[6];
+    const double boreArea = out[2];
+    const double pistonSpeed = out[1];
+    if (!(cutoff > 0.0 && cutoff < 1.0) || !(lap + lead > 0.0) || !(lap >= 0.0) || !(stroke > 0.0)) {
+        return result;
+    }
+
+    // Valve events. The valve moves as r·sin(θ + δ); it opens to steam when that exceeds the lap.
+    // Constant lead fixes r·sin(δ) = lap + lead, and cutoff at θc fixes r·sin(θc + δ) = lap.
+    const double thetaCutoff = crankAngleAt(cutoff, settings.rodRatio);
+    const double rSin = lap + lead;
+    const double rCos = (lap - rSin * std::cos(thetaCutoff)) / std::sin(thetaCutoff);
+    const double radius = std::hypot(rSin, rCos);
+    if (rCos < 0.0 || radius > halfTravel) {
+        return result; // shorter than mid gear gives, or more than the design's full‐gear Half Travel
+    }
+    const double advance = std::atan2(rSin, rCos);
+    const double thetaRelease = M_PI - advance;          // exhaust opens (exhaust lap 0)
+    const double thetaCompression = 2.0 * M_PI - advance; // exhaust closes on the return stroke
+    const double thetaAdmission = 2.0 * M_PI + std::asin(lap / radius) - advance;
+
+    const IndicatorSettings& s = settings;
+    const double boiler = s.boilerPressure + atmosphere;
+    const double back = s.backPressure + atmosphere;
+    const double volumeCutoff = s.clearance + pistonFraction(thetaCutoff, s.rodRatio);
+    const double volumeCompression = s.clearance + pistonFraction(thetaCompression, s.rodRatio);
+
+    // Pressure (psia) in the cylinder end at crank angle theta, for volume (fraction of swept volume).
+    auto pressure = [&](double theta, double volume) {
+        if (theta < thetaCutoff || theta >= thetaAdmission) return boiler;
+        if (theta < thetaRelease) return boiler * std::pow(volumeCutoff / volume, s.expansionIndex);
+        if (theta < thetaCompression) return back;
+        return back * std::pow(volumeCompression / volume, s.expansionIndex);
+    };
+
+    // Work per revolution per cylinder end, in psi × swept volume, i.e. the MEP directly.
+    const int steps = s.crankSteps > 0 ? s.crankSteps : 3600;
+    const double dTheta = 2.0 * M_PI / steps;
+    double work = 0.0;
+    double volumeBefore = s.clearance;
+    for (int k = 0; k < steps; k++) {
+        double thetaMid = (k + 0.5) * dTheta;
+        double volumeAfter = s.clearance + pistonFraction((k + 1) * dTheta, s.rodRatio);
+        double volumeMid = s.clearance + pistonFraction(thetaMid, s.rodRatio);
+        work += pressure(thetaMid, volumeMid) * (volumeAfter - volumeBefore);
+        volumeBefore = volumeAfter;
+    }
+
+    result.reachable = true;
+    result.release = pistonFraction(thetaRelease, s.rodRatio);
+    result.compression = 1.0 - pistonFraction(thetaCompression, s.rodRatio);
+    result.preAdmission = (2.0 * M_PI - thetaAdmission) * 180.0 / M_PI;
+    result.mep = work;
+
+    // Piston Speed already counts both strokes, so this is both ends of a double‐acting cylinder.
+    result.ihp = result.mep * boreArea * pistonSpeed / 33000.0 * s.cylinders;
+
+    // Steam admitted per stroke = what's in the cylinder at cutoff minus what was trapped by compression.
+    const double sweptCubicFeet = boreArea * stroke / 1728.0;
+    const double steamPerStroke = sweptCubicFeet * (volumeCutoff / steamVolume(boiler) - volumeCompression / steamVolume(back));
+    const double strokesPerHour = pistonSpeed / (stroke / 12.0) * 60.0;
+    result.steamPerHour = std::max(0.0, steamPerStroke) * strokesPerHour * s.cylinders;
+    result.waterRate = result.ihp > 0.0 ? result.steamPerHour / result.ihp : 0.0;
+    return result;
+}
+
+void Indicator::evaluateBatch(const DesignBatch& batch, const std::vector<double>& cutoffs,
+    std::vector<IndicatorResult>& results, int threads) const {
+    const size_t rows = batch.size();
+    const size_t perRow = cutoffs.size();
+    const size_t total = rows * perRow;
+    results.assign(total, IndicatorResult());
+    if (total == 0) {
+        return;
+    }
+
+    size_t threadCount = threads > 0 ? static_cast<size_t>(threads) : std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+    if (threadCount > total) threadCount = total;
+
+    // Each thread takes one contiguous block of (design, cutoff) pairs and writes only its own results.
+    auto work = [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            size_t row = k / perRow;
+            double in[Maths::inputCount];
+            double out[Maths::outputCount];
+            for (int i = 0; i < Maths::inputCount; i++) in[i] = batch.in[i][row];
+            for (int o = 0; o < Maths::outputCount; o++) out[o] = batch.out[o][row];
+            results[k] = evaluate(in, out, cutoffs[k % perRow]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threadCount; t++) {
+        pool.emplace_back(work, total * t / threadCount, total * (t + 1) / threadCount);
+    }
+    work(0, total / threadCount);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+bool Indicator::evaluateFile(const std::string& sweepPath, const std::vector<double>& cutoffs,
+    const std::string& outPath, std::ostream& report, int threads) const {
+    std::ifstream sweepFile(sweepPath, std::ios::binary);
+    if (!sweepFile.is_open()) {
+        report << "Error: couldn't open " << sweepPath << ".\n";
+        return false;
+    }
+    std::ofstream outFile(outPath, std::ios::binary);
+    if (!outFile.is_open()) {
+        report << "Error: couldn't open " << outPath << " for writing.\n";
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    DesignBatch batch;
+    std::vector<IndicatorResult> results;
+    std::vector<PowerRecord> records;
+    std::uint64_t design = 0;
+    std::uint64_t reachable = 0;
+    size_t rows;
+    while ((rows = Sweep::readChunk(sweepFile, batch, 16384)) > 0) {
+        evaluateBatch(batch, cutoffs, results, threads);
+        records.resize(results.size());
+        for (size_t k = 0; k < results.size(); k++) {
+            const IndicatorResult& r = results[k];
+            records[k] = PowerRecord{ design + k / cutoffs.size(), r.cutoff, r.mep, r.ihp, r.steamPerHour, r.waterRate };
+            reachable += r.reachable ? 1 : 0;
+        }
+        outFile.write(reinterpret_cast<const char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(PowerRecord)));
+        design += rows;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    report << "Designs: " << design << " x " << cutoffs.size() << " cutoffs written to " << outPath << "\n"
+        << "Reachable cutoffs: " << reachable << " of " << design * cutoffs.size() << "\n"
+        << "Time: " << seconds << " s\n";
+    return true;
+}
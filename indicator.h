@@ -0,0 +1,86 @@
+﻿/*
+ * File: indicator.h
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Declares `Indicator`, which integrates an idealized indicator diagram for a design at a given cutoff and turns
+ *   it into mean effective pressure (MEP), indicated horsepower and steam consumption.
+ *   - `evaluate()`     : one design, one cutoff
+ *   - `evaluateBatch()`: every design of a DesignBatch at every cutoff, split across threads
+ *   - `evaluateFile()` : the same for a whole sweep file, written to a file of PowerRecords
+ *
+ * Developer Notes:
+ *  - The valve events come from the design itself: Lap and Lead fix the valve's advance, so asking for a cutoff
+ *    fixes the valve travel that gear setting needs (constant lead, like Walschaerts gear notched up), and from
+ *    that release, compression and pre‐admission follow (exhaust lap assumed 0). Cutoffs needing more than the
+ *    design's Half Travel output (full gear), or shorter than mid gear gives, are flagged as unreachable.
+ *  - The cycle: admission at boiler pressure until cutoff, expansion (pV^n = const) until release, exhaust at back
+ *    pressure until compression, compression (pV^n) until admission. Integrated as the sum of p·dV over crankSteps.
+ *  - Steam volume uses Zeuner's p·v^1.0646 = 475 (psia, ft³/lb) for dry saturated steam.
+ *  - Power uses the existing Bore Area and Piston Speed outputs, so the same 336 rpm is assumed.
+ */
+
+#ifndef INDICATOR_H
+#define INDICATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "maths.h"
+#include "batch.h"
+
+// Operating conditions shared by every design that gets evaluated.
+struct IndicatorSettings {
+    double boilerPressure = 200.0; // steam chest pressure, psi (gauge)
+    double backPressure = 5.0;     // exhaust back pressure, psi (gauge)
+    double clearance = 0.08;       // clearance volume as a fraction of swept volume
+    double expansionIndex = 1.0;   // n in pV^n = const for expansion and compression (1.0 = hyperbolic)
+    double rodRatio = 8.0;         // connecting rod length / crank radius (0 = ignore rod angularity)
+    int cylinders = 2;
+    int crankSteps = 3600;         // integration steps per revolution
+};
+
+// Result for one design at one cutoff.
+struct IndicatorResult {
+    bool reachable = false;     // false if the valve gear can't give this cutoff (everything else is then 0)
+    double cutoff = 0.0;        // fraction of stroke
+    double release = 0.0;       // fraction of stroke where the exhaust opens
+    double compression = 0.0;   // fraction of stroke remaining when the exhaust closes on the return stroke
+    double preAdmission = 0.0;  // crank angle before dead center where steam is admitted (degrees, the "lead angle")
+    double mep = 0.0;           // mean effective pressure, psi
+    double ihp = 0.0;           // indicated horsepower, all cylinders
+    double steamPerHour = 0.0;  // lb/hr, all cylinders
+    double waterRate = 0.0;     // lb of steam per indicated horsepower‐hour
+};
+
+// One row of the file evaluateFile() writes.
+struct PowerRecord {
+    std::uint64_t design;   // record number in the sweep file
+    double cutoff;
+    double mep;
+    double ihp;
+    double steamPerHour;
+    double waterRate;       // 0 when the cutoff is unreachable
+};
+
+class Indicator {
+public:
+    IndicatorSettings settings;
+
+    // in/out are one design's 7 inputs and 9 outputs (Maths::formulas order); cutoff is a fraction (0..1).
+    IndicatorResult evaluate(const double* in, const double* out, double cutoff) const;
+
+    // results[row * cutoffs.size() + c] = design row at cutoffs[c]. threads = 0 uses every hardware thread.
+    void evaluateBatch(const DesignBatch& batch, const std::vector<double>& cutoffs,
+        std::vector<IndicatorResult>& results, int threads = 0) const;
+
+    // Evaluate every record of a sweep file at every cutoff and write PowerRecords to outPath.
+    bool evaluateFile(const std::string& sweepPath, const std::vector<double>& cutoffs,
+        const std::string& outPath, std::ostream& report, int threads = 0) const;
+};
+
+#endif // INDICATOR_H
@@ -0,0 +1,293 @@
+﻿/*
+ * File: live.cpp
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Implements `LiveEditor`:
+ *   - run(): switch the terminal to raw mode + the alternate screen, then loop: wait for keys (up to the next
+ *            frame), apply them, and redraw once per frame if anything changed. On the way out the terminal is
+ *            restored and mathOutput is recomputed from the edited inputs.
+ *   - buildFrame(): run Maths::formulas() on the current inputs and lay out the inputs/outputs table.
+ *   - diffFrame(): compare against the previous frame and emit cursor moves + only the changed characters.
+ *   - handleKeys(): arrow keys, step changes, typed values, quit; holds back escape sequences split across reads.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include "live.h"
+#include "common.h"
+#include "maths.h"
+
+#ifdef __linux__
+#include <termios.h>
+#include <unistd.h>
+#include <sys/select.h>
+#endif
+
+namespace {
+    const int frameWidth = 80; // every row is padded to this width so rows can be compared cell by cell
+
+    std::string padRow(std::string row) {
+        row.resize(frameWidth, ' ');
+        return row;
+    }
+
+    std::string formatValue(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%14.4f", value);
+        return buffer;
+    }
+
+    // A lone ESC is only "quit" if nothing follows it within this long; arrow keys send ESC [ A in one burst.
+    const auto escapeTimeout = std::chrono::milliseconds(50);
+}
+
+#ifdef __linux__
+namespace {
+    termios savedTerminal; // the settings run() found, for restoreTerminal()
+
+    // SIGTERM/SIGHUP while editing: put the terminal back, then end the way the signal normally would.
+    // Only async‐signal‐safe calls (write, tcsetattr, signal, raise) are used here.
+    void restoreTerminal(int signal) {
+        const char leave[] = "\x1b[?25h\x1b[?1049l";
+        ssize_t written = write(STDOUT_FILENO, leave, sizeof(leave) - 1);
+        (void)written;
+        tcsetattr(STDIN_FILENO, TCSANOW, &savedTerminal);
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+}
+#endif
+
+std::vector<std::string> LiveEditor::buildFrame(Maths& maths) const {
+    double in[Maths::inputCount];
+    double out[Maths::outputCount];
+    for (int i = 0; i < Maths::inputCount; i++) {
+        in[i] = maths.mathInput[i + 1].input;
+    }
+    Maths::formulas(in, out);
+
+    std::vector<std::string> frame;
+    frame.push_back(padRow("| Live Edit | Up/Down select, Left/Right nudge, [ ] step, type + Enter, q exit"));
+    char stepText[32];
+    std::snprintf(stepText, sizeof(stepText), "Step: %g", step);
+    frame.push_back(padRow(stepText));
+    frame.push_back(padRow(""));
+    frame.push_back(padRow("Inputs"));
+    for (int i = 0; i < Maths::inputCount; i++) {
+        auto& lookfor = maths.mathInput[i + 1];
+        std::string value = (i == selected && !typing.empty()) ? typing + "_" : formatValue(lookfor.input);
+        std::string row = (i == selected ? " > [" : "   [") + lookfor.inputLetter + "] " + lookfor.inputName;
+        row.resize(36, ' ');
+        frame.push_back(padRow(row + value));
+    }
+    frame.push_back(padRow(""));
+    frame.push_back(padRow("Outputs"));
+    for (int o = 0; o < Maths::outputCount; o++) {
+        auto& lookfor = maths.mathOutput[o + 1];
+        std::string row = "   [" + lookfor.outputLetter + "] " + lookfor.outputName;
+        row.resize(36, ' ');
+        // Same rule visualMath() uses: a negative (or NaN) output means the inputs don't make sense.
+        bool invalid = !(out[o] >= 0);
+        frame.push_back(padRow(row + formatValue(out[o]) + (invalid ? "  invalid" : "")));
+    }
+    return frame;
+}
+
+std::string LiveEditor::diffFrame(const std::vector<std::string>& frame) {
+    std::string update;
+    for (size_t row = 0; row < frame.size(); row++) {
+        const std::string& now = frame[row];
+        if (row >= previousFrame.size()) {
+            update += "\x1b[" + std::to_string(row + 1) + ";1H" + now;
+            continue;
+        }
+        const std::string& before = previousFrame[row];
+        if (now == before) {
+            continue;
+        }
+        // Rewrite only the span between the first and last changed character of this row.
+        size_t first = 0;
+        while (now[first] == before[first]) first++;
+        size_t last = now.size() - 1;
+        while (now[last] == before[last]) last--;
+        update += "\x1b[" + std::to_string(row + 1) + ";" + std::to_string(first + 1) + "H"
+            + now.substr(first, last - first + 1);
+    }
+    previousFrame = frame;
+    return update;
+}
+
+bool LiveEditor::handleKeys(const std::string& chunk, Maths& maths) {
+    const std::string keys = pending + chunk;
+    pending.clear();
+    for (size_t k = 0; k < keys.size(); k++) {
+        char c = keys[k];
+        if (c == '\x1b') {
+            // Arrow keys arrive as ESC [ A..D or ESC O A..D, possibly with parameters (ESC [ 1 ; 5 C).
+            if (k + 1 == keys.size()) {
+                pending = keys.substr(k); // lone ESC so far; run() decides once escapeTimeout passes
+                return true;
+            }
+            if (keys[k + 1] != '[' && keys[k + 1] != 'O') {
+                k++; // ESC + key (Alt chord): not a bare ESC, and the key itself is skipped too
+                continue;
+            }
+            size_t end = k + 2;
+            if (keys[k + 1] == '[') {
+                while (end < keys.size() && keys[end] >= 0x30 && keys[end] <= 0x3f) end++;
+            }
+            if (end >= keys.size()) {
+                pending = keys.substr(k); // rest of the sequence is in the next read
+                return true;
+            }
+            char arrow = keys[end];
+            k = end;
+            auto& value = maths.mathInput[selected + 1].input;
+            switch (arrow) {
+            case 'A': selected = (selected + Maths::inputCount - 1) % Maths::inputCount; typing.clear(); break;
+            case 'B': selected = (selected + 1) % Maths::inputCount; typing.clear(); break;
+            case 'C': value += step; typing.clear(); break;
+            case 'D': value -= step; typing.clear(); break;
+            default: break;
+            }
+            continue;
+        }
+        switch (c) {
+        case 'q':
+        case 'Q':
+        case '\x03': // Ctrl-C (ISIG is off, so it arrives as a key)
+            return false;
+        case '[':
+            step /= 10.0;
+            break;
+        case ']':
+            step *= 10.0;
+            break;
+        case '\r':
+        case '\n':
+            if (!typing.empty()) {
+                maths.mathInput[selected + 1].input = std::atof(typing.c_str());
+                typing.clear();
+            }
+            break;
+        case 127:  // Backspace
+        case '\b':
+            if (!typing.empty()) typing.pop_back();
+            break;
+        default:
+            if ((c >= '0' && c <= '9') || c == '.') {
+                typing += c;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+#ifdef __linux__
+void LiveEditor::run(commonFunctions& common, Maths& maths) {
+    termios original;
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &original) != 0) {
+        std::cout << "Live edit needs an interactive terminal.\n";
+        common.delayEffect(1500);
+        common.clearPreviousLines(1);
+        return;
+    }
+    savedTerminal = original;
+    auto previousTerm = std::signal(SIGTERM, restoreTerminal);
+    auto previousHup = std::signal(SIGHUP, restoreTerminal);
+    termios raw = original;
+    raw.c_lflag &= ~(ICANON | ECHO | ISIG);
+    raw.c_cc[VMIN] = 0;
+    raw.c_cc[VTIME] = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+
+    // Alternate screen + hidden cursor, so leaving puts the menus back exactly as they were.
+    std::cout << "\x1b[?1049h\x1b[?25l\x1b[2J" << std::flush;
+    previousFrame.clear();
+    typing.clear();
+    pending.clear();
+
+    using clock = std::chrono::steady_clock;
+    const auto frameInterval = std::chrono::microseconds(1000000 / framesPerSecond);
+    auto nextFrame = clock::now();
+    auto pendingSince = nextFrame;
+    bool dirty = true;
+    bool running = true;
+
+    while (running) {
+        auto now = clock::now();
+        if (!pending.empty() && now >= pendingSince + escapeTimeout) {
+            // Nothing completed the sequence in time: a lone ESC is the Esc key, anything longer is dropped.
+            running = pending != "\x1b";
+            pending.clear();
+            continue;
+        }
+        if (now >= nextFrame) {
+            if (dirty) {
+                std::string update = diffFrame(buildFrame(maths));
+                if (!update.empty()) {
+                    // One write per frame keeps the number of packets down on slow links.
+                    ssize_t written = write(STDOUT_FILENO, update.data(), update.size());
+                    (void)written;
+                }
+                dirty = false;
+            }
+            nextFrame += frameInterval;
+            if (nextFrame < now) {
+                nextFrame = now + frameInterval; // fell behind, don't try to catch up with a burst of frames
+            }
+            continue;
+        }
+
+        // Sleep until either a key arrives, the next frame is due or a held‐back ESC times out.
+        auto wakeUp = nextFrame;
+        if (!pending.empty() && pendingSince + escapeTimeout < wakeUp) {
+            wakeUp = pendingSince + escapeTimeout;
+        }
+        auto wait = std::chrono::duration_cast<std::chrono::microseconds>(wakeUp - now);
+        timeval timeout{ static_cast<time_t>(wait.count() / 1000000), static_cast<suseconds_t>(wait.count() % 1000000) };
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(STDIN_FILENO, &readable);
+        if (select(STDIN_FILENO + 1, &readable, nullptr, nullptr, &timeout) > 0) {
+            char buffer[256];
+            ssize_t count = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (count > 0) {
+                bool wasPending = !pending.empty();
+                running = handleKeys(std::string(buffer, static_cast<size_t>(count)), maths);
+                if (!pending.empty() && !wasPending) {
+                    pendingSince = clock::now();
+                }
+                dirty = true;
+            }
+        }
+    }
+
+    std::cout << "\x1b[?25h\x1b[?1049l" << std::flush;
+    tcsetattr(STDIN_FILENO, TCSANOW, &original);
+    std::signal(SIGTERM, previousTerm);
+    std::signal(SIGHUP, previousHup);
+
+    // Bring mathOutput in line with the edited inputs, as if they had been entered through the calculator.
+    maths.theActualMath();
+}
+#else
+void LiveEditor::run(commonFunctions& common, Maths& maths) {
+    std::string input; // Variable that handles error input.
+    std::cout << "Live edit uses raw terminal input and is only available on Linux for now.\n"
+        << "Enter anything to Exit.\n> ";
+    std::cin >> input;
+    common.handlingBadInput();
+    common.clearPreviousLines(30);
+}
+#endif
@@ -0,0 +1,59 @@
+﻿/*
+ * File: live.h
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Declares `LiveEditor`, a full‐screen mode where the 7 inputs are editable fields and
+ *   all 9 outputs are recomputed on every keystroke.
+ *   - Up/Down      : select an input
+ *   - Left/Right   : nudge the selected input down/up by `step`
+ *   - [ / ]        : divide/multiply `step` by 10
+ *   - digits, '.'  : type a new value, Enter to apply, Backspace to erase
+ *   - q, Esc, ^C   : leave (the edited values stay in mathInput, and mathOutput is recomputed from them)
+ *
+ * Developer Notes:
+ *  - Only the parts of the screen that changed since the last frame are sent to the terminal, and at most
+ *    60 frames per second are drawn, so holding an arrow key down over SSH doesn't flood the link.
+ *  - Raw keyboard input uses termios, so this mode is only available on Linux.
+ *  - Ctrl‐C is read as a key rather than raising SIGINT, and SIGTERM/SIGHUP restore the terminal before the
+ *    program ends, so the shell is never left in raw mode on the alternate screen.
+ */
+
+#ifndef LIVE_H
+#define LIVE_H
+
+#include <string>
+#include <vector>
+
+class commonFunctions;
+class Maths;
+
+class LiveEditor {
+public:
+    double step = 0.1;          // how much Left/Right changes the selected input
+    int framesPerSecond = 60;   // redraw cap
+
+    // Run the live editor until the user quits. Edits are written straight into maths.mathInput.
+    void run(commonFunctions& common, Maths& maths);
+
+private:
+    int selected = 0;                         // index (0..6) of the input being edited
+    std::string typing;                       // characters typed for the selected input, not applied yet
+    std::vector<std::string> previousFrame;   // what is currently on the screen, one string per row
+    std::string pending;                      // start of an escape sequence whose remaining bytes haven't arrived
+
+    // Recompute the outputs and lay out the whole screen as fixed‐width rows.
+    std::vector<std::string> buildFrame(Maths& maths) const;
+
+    // Escape sequences that turn previousFrame into frame, touching only changed cells.
+    std::string diffFrame(const std::vector<std::string>& frame);
+
+    // Apply a chunk of raw key bytes. An escape sequence cut off at the end of the chunk is kept in pending
+    // and finished by the next chunk. Returns false once the user asked to leave.
+    bool handleKeys(const std::string& keys, Maths& maths);
+};
+
+#endif // LIVE_H
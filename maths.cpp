@@ -3,7 +3,7 @@
  * Copyright 2025 Deaven S. Garcia
  * Author: Deaven Garcia (https://github.com/Spitfirebruh)
  * Created: 6/4/25
- * Last Updated: 6/4/25
+ * Last Updated: 10/18/26
  *
  * Description:
  *   Implements the core valve‐gear calculations for the “Valve Gear Calculator” tool.
@@ -145,33 +145,17 @@ void Maths::visualMath(commonFunctions& common) {
 }
 
 // Contains all the engineering formulas. Each mathOutput[index].output field is computed from mathInput values
+// by Maths::formulas() (see maths.h for the individual steps).
 void Maths::theActualMath() {
-    // 1. Wheel Speed (WS) = (Drive Wheel Diameter × π × 336 × 60) / 12
-    mathOutput[1].output = (mathInput[1].input * M_PI * 336 * 60) / 12;
-
-    // 2. Piston Speed (FPM) = (336 × 2 × Piston Stroke) / 12
-    mathOutput[2].output = (336 * 2 * mathInput[2].input) / 12;
-
-    // 3. Bore Area (BA) = π × (Bore / 2)²
-    mathOutput[3].output = (M_PI * pow((mathInput[3].input / 2), 2));
-
-    // 4. Volume Swept per Minute (VPM) = (Piston Speed × Bore Area) / 144
-    mathOutput[4].output = (mathOutput[2].output * mathOutput[3].output) / 144;
-
-    // 5. Port Area (PA) = VPM / 7874
-    mathOutput[5].output = mathOutput[4].output / 7874;
-
-    // 6. Port Height (PH) = (Port Area × 12) / Port Width
-    mathOutput[6].output = (mathOutput[5].output * 12.0) / mathInput[7].input;
-
-    // 7. Half Travel (HT) = Lap + Lead + Port Height
-    mathOutput[7].output = mathInput[5].input + mathInput[4].input + mathOutput[6].output;
+    double in[inputCount];
+    double out[outputCount];
+    for (int i = 0; i < inputCount; i++) {
+        in[i] = mathInput[i + 1].input;
+    }
 
-    // 8. Travel Margin (TM) = Valve Travel – (Lap + Lead)
-    mathOutput[8].output = mathInput[6].input - (mathInput[5].input + mathInput[4].input);
+    formulas(in, out);
 
-    // 9. Combination Lever Length (CLL) = (Piston Stroke × HT) / (2 × ((Lap + Lead) / 2))
-    mathOutput[9].output =
-        (mathInput[2].input * mathOutput[7].output) /
-        (2.0 * ((mathInput[5].input + mathInput[4].input) / 2.0));
+    for (int i = 0; i < outputCount; i++) {
+        mathOutput[i + 1].output = out[i];
+    }
 }
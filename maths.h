@@ -3,7 +3,7 @@
  * Copyright 2025 Deaven S. Garcia
  * Author: Deaven Garcia (https://github.com/Spitfirebruh)
  * Created: 6/4/25
- * Last Updated: 6/4/25
+ * Last Updated: 10/18/26
  *
  * Description:
  *   Defines the `Maths` class, which holds all input parameters and output results for
@@ -12,6 +12,8 @@
  *   - `breakItDown()`: Validate inputs, then run `theActualMath()` and `visualMath()` before optionally saving.
  *   - `visualMath()`: Show a simple ASCII progress bar for each output, then print the final value.
  *   - `theActualMath()`: Perform the core formulas (wheel speed, piston speed, bore area, etc.).
+ *   - `formulas<T>()`: The same formulas, templated on the scalar type so they can also run on dual numbers
+ *                      (sensitivity.h) or lane packs (batched evaluation).
  */
 
 #ifndef MATHS_H
@@ -86,6 +88,51 @@ public:
 
     // Perform all engineering formulas to fill mathOutput[*].output fields.
     void theActualMath();
+
+    // Number of inputs (D, S, B, L, A, T, W) and outputs (WS ... CLL) the formulas work on.
+    static constexpr int inputCount = 7;
+    static constexpr int outputCount = 9;
+
+    // The formulas behind theActualMath(), templated on the scalar type.
+    // in[0..6] holds mathInput[1..7] and out[0..8] receives mathOutput[1..9].
+    template <typename T>
+    static void formulas(const T* in, T* out);
 };
 
+// Same literal as M_PI, kept here so the header doesn't depend on _USE_MATH_DEFINES.
+constexpr double valveGearPi = 3.14159265358979323846;
+
+// Kept in the header so every scalar type (double, Dual, Lanes) gets its own instantiation.
+// Only +, -, *, / are used so any type with those operators works.
+template <typename T>
+void Maths::formulas(const T* in, T* out) {
+    // 1. Wheel Speed (WS) = (Drive Wheel Diameter × π × 336 × 60) / 12
+    out[0] = (in[0] * valveGearPi * 336 * 60) / 12;
+
+    // 2. Piston Speed (FPM) = (336 × 2 × Piston Stroke) / 12
+    out[1] = (336 * 2 * in[1]) / 12;
+
+    // 3. Bore Area (BA) = π × (Bore / 2)²
+    T halfBore = in[2] / 2;
+    out[2] = valveGearPi * (halfBore * halfBore);
+
+    // 4. Volume Swept per Minute (VPM) = (Piston Speed × Bore Area) / 144
+    out[3] = (out[1] * out[2]) / 144;
+
+    // 5. Port Area (PA) = VPM / 7874
+    out[4] = out[3] / 7874;
+
+    // 6. Port Height (PH) = (Port Area × 12) / Port Width
+    out[5] = (out[4] * 12.0) / in[6];
+
+    // 7. Half Travel (HT) = Lap + Lead + Port Height
+    out[6] = in[4] + in[3] + out[5];
+
+    // 8. Travel Margin (TM) = Valve Travel – (Lap + Lead)
+    out[7] = in[5] - (in[4] + in[3]);
+
+    // 9. Combination Lever Length (CLL) = (Piston Stroke × HT) / (2 × ((Lap + Lead) / 2))
+    out[8] = (in[1] * out[6]) / (2.0 * ((in[4] + in[3]) / 2.0));
+}
+
 #endif // MATHS_H
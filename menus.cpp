@@ -3,7 +3,7 @@
  * Copyright 2025 Deaven S. Garcia
  * Author: Deaven Garcia (https://github.com/Spitfirebruh)
  * Created: 5/31/25
- * Last Updated: 6/4/25
+ * Last Updated: 10/18/26
  *
  * Description:
  *   Implements all menu‐driven user‐interaction routines for:
@@ -11,6 +11,12 @@
  *   - Help: show “Getting the right input values” or “Formatting files” info screens.
  *   - Input/Files/Settings: stub functions that display instructional text until fully implemented.
  *   - Saves: checks whether any outputs exist, and if so, calls commonFunctions::saveFile().
+ *   - Live Edit: full‐screen editor that recomputes every output on each keystroke (see live.cpp).
+ *   - Sweep: evaluates a grid of designs with worker processes and writes them to outputs/sweep.bin (see sweep.cpp).
+ *   - Power: indicator diagram → MEP, indicated horsepower and steam use, for one design or a sweep (see indicator.cpp).
+ *   - Catalogue: nearest known locomotives to a design or to every design in a sweep (see catalogue.cpp).
+ *   - Pareto: best trade‐offs among the designs of a sweep for chosen objectives (see pareto.cpp).
+ *   - Sensitivity: prints d(output)/d(input) for the current inputs, computed with dual numbers.
  *
  * Developer Note: Some code is duplicated across menus (e.g., stalling for “Enter anything to exit”),
  *               so future refactoring could DRY it up.
@@ -20,16 +26,28 @@
 #include <sstream>
 #include <fstream>
 #include <string>
+#include <iomanip>
+#include <cmath>
 #include "menus.h"
 #include "common.h"
 #include "maths.h"
+#include "sensitivity.h"
+#include "validation.h"
+#include "indicator.h"
+#include "pareto.h"
 
  // The main calculator menu loop:
  // 1. Calculate → calls maths.breakItDown()
- // 2. Manual Input → calls maths.takeInputs()
+ // 2. Manual Input → calls maths.takeInputs(), then closest()
  // 3. File Input → calls common.loadFile()
  // 4. File Output → calls saves()
- // 5. Exit → break loop
+ // 5. Sensitivity → calls sensitivity()
+ // 6. Live Edit → calls liveEditor.run()
+ // 7. Sweep → calls sweep()
+ // 8. Power → calls power()
+ // 9. Catalogue → calls catalogues()
+ // 10. Pareto → calls pareto()
+ // 11. Exit → break loop
 void Menu::calculator(commonFunctions& common, Maths& maths) {
     int input = 0;       // menu choice
     std::string input2; // Variable that handles error input.
@@ -41,7 +59,13 @@ void Menu::calculator(commonFunctions& common, Maths& maths) {
             << "2. Manual Input\n"
             << "3. File Input\n"
             << "4. File Output\n"
-            << "5. Exit\n> ";
+            << "5. Sensitivity\n"
+            << "6. Live Edit\n"
+            << "7. Sweep\n"
+            << "8. Power\n"
+            << "9. Catalogue\n"
+            << "10. Pareto\n"
+            << "11. Exit\n> ";
         std::cin >> input;
         common.handlingBadInput();
         switch (input) {
@@ -51,6 +75,7 @@ void Menu::calculator(commonFunctions& common, Maths& maths) {
             break;
         case 2:
             maths.takeInputs();
+            closest(common, maths);
             common.clearPreviousLines(30);
             break;
         case 3:
@@ -61,6 +86,25 @@ void Menu::calculator(commonFunctions& common, Maths& maths) {
             saves(common, maths);
             break;
         case 5:
+            sensitivity(common, maths);
+            break;
+        case 6:
+            liveEditor.run(common, maths);
+            common.clearPreviousLines(30);
+            break;
+        case 7:
+            sweep(common, maths);
+            break;
+        case 8:
+            power(common, maths);
+            break;
+        case 9:
+            catalogues(common, maths);
+            break;
+        case 10:
+            pareto(common, maths);
+            break;
+        case 11:
             common.clearPreviousLines(30);
             loop = 0;
             break;
@@ -254,3 +298,303 @@ void Menu::saves(commonFunctions& common, Maths& maths) {
     }
     common.clearPreviousLines(30);
 }
+
+// The Sensitivity menu:
+// 1. Current design → differentiate every output with respect to every input at the current values and print:
+//    - the Jacobian (how much each output changes per 1" change of each input)
+//    - the input with the largest relative effect on each output
+// 2. Sweep file → Sensitivity::evaluateFile() into outputs/sensitivity.bin
+void Menu::sensitivity(commonFunctions& common, Maths& maths) {
+    std::string input; // Variable that handles error input.
+    int choice = 0;
+
+    std::cout << "| Sensitivity |\n"
+        << "1. Current design\n"
+        << "2. Sweep file (" << Sweep::defaultPath << ")\n> ";
+    std::cin >> choice;
+    common.handlingBadInput();
+
+    if (choice == 1) {
+        for (int i = 1; maths.mathInput.find(i) != maths.mathInput.end(); i++) {
+            if (maths.mathInput[i].input <= 0.0) {
+                std::cout << "Input for [" << maths.mathInput[i].inputName << "] is either invalid "
+                    << "or not entered yet.\nEnter anything to continue.\n> ";
+                std::cin >> input;
+                common.handlingBadInput();
+                common.clearPreviousLines(30);
+                return;
+            }
+        }
+
+        Sensitivity sens;
+        sens.evaluate(maths);
+
+        std::cout << "| Sensitivity | d(Output) / d(Input)\n" << std::setw(6) << "";
+        for (int i = 1; i <= Maths::inputCount; i++) {
+            std::cout << std::setw(12) << maths.mathInput[i].inputLetter;
+        }
+        std::cout << std::setw(14) << "Most by" << "\n";
+
+        for (int o = 0; o < Maths::outputCount; o++) {
+            std::cout << std::setw(6) << maths.mathOutput[o + 1].outputLetter;
+            int strongest = 0;
+            for (int i = 0; i < Maths::inputCount; i++) {
+                std::cout << std::setw(12) << std::setprecision(5) << sens.jacobian[o][i];
+                if (std::fabs(sens.elasticity(maths, o, i)) > std::fabs(sens.elasticity(maths, o, strongest))) {
+                    strongest = i;
+                }
+            }
+            std::cout << std::setw(10) << maths.mathInput[strongest + 1].inputLetter
+                << " (" << std::setprecision(3) << sens.elasticity(maths, o, strongest) << "%/%)\n";
+        }
+        std::cout << std::setprecision(6)
+            << "\"Most by\" is the input whose 1% change moves that output the most.\n";
+    }
+    else if (choice == 2) {
+        Sensitivity::evaluateFile(Sweep::defaultPath, "outputs/sensitivity.bin", std::cout);
+    }
+    else {
+        std::cout << "[Invalid option]\n";
+    }
+
+    std::cout << "Enter anything to Exit.\n> ";
+    std::cin >> input;
+    common.handlingBadInput();
+    common.clearPreviousLines(40);
+}
+
+// Prompt for a range per input and the number of workers, then run the sweep and show its report.
+// Every written design is then checked; bad rows are flagged in outputs/sweep.mask rather than stopping the sweep.
+void Menu::sweep(commonFunctions& common, Maths& maths) {
+    std::string input; // Variable that handles error input.
+
+    if (sweeper.takeRanges(common, maths)) {
+        std::cout << "Designs to evaluate: " << sweeper.totalDesigns() << "\n"
+            << "Worker processes (0 = one per CPU)\n> ";
+        std::cin >> sweeper.workers;
+        common.handlingBadInput();
+
+        SweepStatus status = sweeper.run(Sweep::defaultPath, std::cout);
+        if (status == SweepStatus::complete) {
+            std::cout << "Sweep completed successfully.\n";
+        }
+
+        // Only check a file this sweep wrote; after a failed start it still holds the previous sweep.
+        Validation validation;
+        if (status != SweepStatus::notStarted
+            && validation.validateFile(Sweep::defaultPath, "outputs/sweep.mask", std::cout)) {
+            validation.printSummary(maths, std::cout);
+        }
+        std::cout << "Enter anything to Exit.\n> ";
+        std::cin >> input;
+        common.handlingBadInput();
+    }
+    common.clearPreviousLines(40);
+}
+
+// Ask for boiler pressure and cutoff, then either:
+// 1. evaluate the indicator diagram of the current design and print the valve events and power, or
+// 2. evaluate every design in outputs/sweep.bin over a range of cutoffs into outputs/power.bin.
+void Menu::power(commonFunctions& common, Maths& maths) {
+    std::string input; // Variable that handles error input.
+    int choice = 0;
+    Indicator indicator;
+
+    std::cout << "| Power |\n"
+        << "1. Current design\n"
+        << "2. Sweep file (" << Sweep::defaultPath << ")\n> ";
+    std::cin >> choice;
+    common.handlingBadInput();
+
+    std::cout << "Boiler pressure (psi)\n"
+        << "Example: [" << indicator.settings.boilerPressure << "]\n> ";
+    std::cin >> indicator.settings.boilerPressure;
+    if (std::cin.fail() || indicator.settings.boilerPressure <= 0.0) {
+        common.handlingBadInput();
+        std::cout << "Boiler pressure is invalid.\nEnter anything to continue.\n> ";
+        std::cin >> input;
+        common.clearPreviousLines(30);
+        return;
+    }
+
+    if (choice == 1) {
+        for (int i = 1; maths.mathInput.find(i) != maths.mathInput.end(); i++) {
+            if (maths.mathInput[i].input <= 0.0) {
+                std::cout << "Input for [" << maths.mathInput[i].inputName << "] is either invalid "
+                    << "or not entered yet.\nEnter anything to continue.\n> ";
+                std::cin >> input;
+                common.handlingBadInput();
+                common.clearPreviousLines(30);
+                return;
+            }
+        }
+        double cutoff = 0.0;
+        std::cout << "Cutoff (% of stroke)\nExample: [25]\n> ";
+        std::cin >> cutoff;
+        common.handlingBadInput();
+
+        double in[Maths::inputCount];
+        double out[Maths::outputCount];
+        for (int i = 0; i < Maths::inputCount; i++) in[i] = maths.mathInput[i + 1].input;
+        Maths::formulas(in, out);
+        IndicatorResult result = indicator.evaluate(in, out, cutoff / 100.0);
+
+        if (!result.reachable) {
+            std::cout << "A " << cutoff << "% cutoff can't be reached with this Lap, Lead and Half Travel.\n";
+        }
+        else {
+            std::cout << "Release: " << result.release * 100.0 << "% of stroke\n"
+                << "Compression: last " << result.compression * 100.0 << "% of stroke\n"
+                << "Pre-admission: " << result.preAdmission << " degrees before dead center\n"
+                << "Mean Effective Pressure: " << result.mep << " psi\n"
+                << "Indicated Horsepower: " << result.ihp << " (" << indicator.settings.cylinders << " cylinders)\n"
+                << "Steam Consumption: " << result.steamPerHour << " lb/hr\n"
+                << "Water Rate: " << result.waterRate << " lb/ihp-hr\n";
+        }
+    }
+    else if (choice == 2) {
+        SweepRange cutoffs;
+        std::cout << "Cutoffs (% of stroke): from, to, steps\nExample: [15 45 7]\n> ";
+        std::cin >> cutoffs.from >> cutoffs.to >> cutoffs.steps;
+        if (std::cin.fail() || cutoffs.steps < 1) {
+            common.handlingBadInput();
+            std::cout << "Cutoff range is invalid.\nEnter anything to continue.\n> ";
+            std::cin >> input;
+            common.clearPreviousLines(30);
+            return;
+        }
+        std::vector<double> list;
+        for (int k = 0; k < cutoffs.steps; k++) {
+            double percent = (cutoffs.steps == 1) ? cutoffs.from
+                : cutoffs.from + (cutoffs.to - cutoffs.from) * k / (cutoffs.steps - 1);
+            list.push_back(percent / 100.0);
+        }
+        indicator.evaluateFile(Sweep::defaultPath, list, "outputs/power.bin", std::cout);
+    }
+    else {
+        std::cout << "[Invalid option]\n";
+    }
+
+    std::cout << "Enter anything to Exit.\n> ";
+    std::cin >> input;
+    common.handlingBadInput();
+    common.clearPreviousLines(40);
+}
+
+// The Catalogue menu:
+// 1. Build index → Catalogue::build() from inputs/catalogue.txt, then reopen it
+// 2. Closest to current design → closest()
+// 3. Closest for sweep file → Catalogue::nearestFile() into outputs/nearest.bin
+// 4. Exit
+void Menu::catalogues(commonFunctions& common, Maths& maths) {
+    std::string input; // Variable that handles error input.
+    int choice = 0;
+    int k = 5;
+
+    std::cout << "| Catalogue |\n"
+        << "1. Build index from " << Catalogue::sourcePath << "\n"
+        << "2. Closest to current design\n"
+        << "3. Closest for sweep file (" << Sweep::defaultPath << ")\n"
+        << "4. Exit\n> ";
+    std::cin >> choice;
+    common.handlingBadInput();
+
+    switch (choice) {
+    case 1:
+        catalogue.close(); // the index file is about to be replaced
+        Catalogue::build(Catalogue::sourcePath, Catalogue::indexPath, std::cout);
+        catalogue.open(Catalogue::indexPath);
+        break;
+    case 2:
+        closest(common, maths);
+        common.clearPreviousLines(40);
+        return;
+    case 3:
+        if (!catalogue.isOpen() && !catalogue.open(Catalogue::indexPath)) {
+            std::cout << "No catalogue index found; build it first.\n";
+            break;
+        }
+        std::cout << "Locomotives per design\nExample: [5]\n> ";
+        std::cin >> k;
+        common.handlingBadInput();
+        if (k < 1) k = 5;
+        catalogue.nearestFile(Sweep::defaultPath, k, "outputs/nearest.bin", std::cout);
+        break;
+    case 4:
+        common.clearPreviousLines(30);
+        return;
+    default:
+        std::cout << "[Invalid option]\n";
+        break;
+    }
+
+    std::cout << "Enter anything to Exit.\n> ";
+    std::cin >> input;
+    common.handlingBadInput();
+    common.clearPreviousLines(40);
+}
+
+// Look up the 5 catalogue locomotives closest to the current inputs and list them with their values.
+// Silently returns when no catalogue index exists, so manual input works the same without one.
+void Menu::closest(commonFunctions& common, Maths& maths) {
+    std::string input; // Variable that handles error input.
+    if (!catalogue.isOpen() && !catalogue.open(Catalogue::indexPath)) {
+        return;
+    }
+
+    double inputs[Maths::inputCount];
+    for (int i = 0; i < Maths::inputCount; i++) inputs[i] = maths.mathInput[i + 1].input;
+    std::vector<CatalogueMatch> matches;
+    catalogue.nearest(inputs, 5, matches);
+
+    std::cout << "Closest of " << catalogue.size() << " catalogued locomotives:\n";
+    for (const CatalogueMatch& match : matches) {
+        double values[Maths::inputCount];
+        catalogue.values(match.id, values);
+        std::cout << " - " << catalogue.name(match.id) << " (distance " << std::setprecision(3) << match.distance << ")\n   ";
+        for (int i = 0; i < Maths::inputCount; i++) {
+            std::cout << maths.mathInput[i + 1].inputLetter << "=" << std::setprecision(4) << values[i] << " ";
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::setprecision(6) << "Enter anything to continue.\n> ";
+    std::cin >> input;
+    common.handlingBadInput();
+}
+
+// Read objectives (letter + direction) and constraints (letter <= / >= value) as one line each,
+// then extract the Pareto front of the last sweep.
+void Menu::pareto(commonFunctions& common, Maths& maths) {
+    std::string input; // Variable that handles error input.
+    std::string line;
+    Pareto front;
+
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // drop the rest of the menu choice line
+    std::cout << "Objectives: output/input letters followed by + (maximize) or - (minimize)\n"
+        << "Example: [TM+ PH- CLL-]\n> ";
+    std::getline(std::cin, line);
+    if (!front.parseObjectives(maths, line)) {
+        std::cout << "Objectives are invalid.\nEnter anything to continue.\n> ";
+        std::cin >> input;
+        common.handlingBadInput();
+        common.clearPreviousLines(30);
+        return;
+    }
+
+    std::cout << "Constraints: letter<=value or letter>=value, or none\n"
+        << "Example: [D<=72 B<=22]\n> ";
+    std::getline(std::cin, line);
+    if (!front.parseConstraints(maths, line)) {
+        std::cout << "Constraints are invalid.\nEnter anything to continue.\n> ";
+        std::cin >> input;
+        common.handlingBadInput();
+        common.clearPreviousLines(30);
+        return;
+    }
+
+    front.extractFile(maths, Sweep::defaultPath, "outputs/pareto.txt", std::cout);
+    std::cout << "Enter anything to Exit.\n> ";
+    std::cin >> input;
+    common.handlingBadInput();
+    common.clearPreviousLines(40);
+}
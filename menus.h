@@ -3,11 +3,11 @@
  * Copyright 2025 Deaven S. Garcia
  * Author: Deaven Garcia (https://github.com/Spitfirebruh)
  * Created: 5/31/25
- * Last Updated: 6/4/25
+ * Last Updated: 10/18/26
  *
  * Description:
  *   Declares the `Menu` class, which encapsulates all user‐interaction menus for:
- *   - Calculator (calculate, manual input, file input, file output, exit)
+ *   - Calculator (calculate, manual input, file input, file output, sensitivity, live edit, sweep, power, catalogue, pareto, exit)
  *   - Help (input guidance, file formatting guidance, exit)
  *   - Settings (stub for future options)
  *   - Saves (checks for computed results, then triggers saving)
@@ -19,6 +19,9 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include "live.h"
+#include "sweep.h"
+#include "catalogue.h"
 
 class commonFunctions; // forward‐declare to avoid circular include
 class Maths;
@@ -27,6 +30,12 @@ class Menu {
 public:
     // Easter Egg for a bug that exists
     int yesIKnowThisIsAnIssue = 1;
+    // Kept here so the live edit step survives leaving and re-entering live mode
+    LiveEditor liveEditor;
+    // Kept here so the last sweep ranges can be reused
+    Sweep sweeper;
+    // Opened on first use, then stays mapped for quick lookups
+    Catalogue catalogue;
     // Display the calculator menu and handle user choices
     void calculator(commonFunctions& common, Maths& maths);
 
@@ -44,6 +53,24 @@ public:
 
     // Check if results exist; if so, call saveFile(), else warn user
     void saves(commonFunctions& common, Maths& maths);
+
+    // Show how strongly each output responds to each input (Jacobian + most influential input per output)
+    void sensitivity(commonFunctions& common, Maths& maths);
+
+    // Ask for input ranges and a worker count, evaluate the whole grid into outputs/sweep.bin, then validate it
+    void sweep(commonFunctions& common, Maths& maths);
+
+    // Indicator diagram for the current design or a sweep file: MEP, indicated horsepower and steam use at a cutoff
+    void power(commonFunctions& common, Maths& maths);
+
+    // Catalogue menu: build the index, look up the current design, or look up every design in a sweep file
+    void catalogues(commonFunctions& common, Maths& maths);
+
+    // Print the catalogue locomotives closest to the current inputs (does nothing if there is no catalogue)
+    void closest(commonFunctions& common, Maths& maths);
+
+    // Ask for objectives and constraints, then write the Pareto front of outputs/sweep.bin to outputs/pareto.txt
+    void pareto(commonFunctions& common, Maths& maths);
 };
 
 #endif // MENUS_H
@@ -0,0 +1,268 @@
+﻿/*
+ * File: pareto.cpp
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Implements `Pareto`:
+ *   - parseObjectives()/parseConstraints(): turn the user's text into column numbers and limits.
+ *   - frontOf(): filter a block of rows (valid + within constraints), then sort‐filter‐skyline.
+ *   - merge(): sort‐filter‐skyline over the union of two fronts.
+ *   - extractFile(): chunk → per‐thread fronts → pairwise parallel merges → running front → outputs/pareto.txt.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include "pareto.h"
+#include "validation.h"
+#include "sweep.h"
+#include "maths.h"
+
+namespace {
+    // a is no worse than b on every key (keys are "smaller is better"): a dominates b, or they are equal.
+    bool weaklyDominates(const double* a, const double* b, std::size_t m) {
+        for (std::size_t j = 0; j < m; j++) {
+            if (a[j] > b[j]) return false;
+        }
+        return true;
+    }
+
+    // Sort‐filter‐skyline. Candidates are visited in order of key sum (ties broken lexicographically), an order in
+    // which a point can only be dominated by points before it, so each one is checked against the kept ones only.
+    // A candidate equal to a kept point is dropped too, so designs that differ only in inputs that aren't
+    // objectives give one row per trade‐off instead of multiplying the front.
+    ParetoFront skyline(const std::vector<SweepRecord>& records, const std::vector<double>& keys, std::size_t m,
+        std::uint64_t considered) {
+        const std::size_t count = records.size();
+        std::vector<double> sums(count, 0.0);
+        for (std::size_t r = 0; r < count; r++) {
+            for (std::size_t j = 0; j < m; j++) sums[r] += keys[r * m + j];
+        }
+        std::vector<std::size_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            if (sums[a] != sums[b]) return sums[a] < sums[b];
+            return std::lexicographical_compare(keys.begin() + a * m, keys.begin() + (a + 1) * m,
+                keys.begin() + b * m, keys.begin() + (b + 1) * m);
+        });
+
+        ParetoFront front;
+        front.considered = considered;
+        for (std::size_t r : order) {
+            const double* candidate = keys.data() + r * m;
+            bool dominated = false;
+            for (std::size_t kept = 0; kept < front.records.size() && !dominated; kept++) {
+                dominated = weaklyDominates(front.keys.data() + kept * m, candidate, m);
+            }
+            if (!dominated) {
+                front.records.push_back(records[r]);
+                front.keys.insert(front.keys.end(), candidate, candidate + m);
+            }
+        }
+        return front;
+    }
+
+    // Value of column (0..15) in a record.
+    double columnValue(const SweepRecord& record, int column) {
+        return column < Maths::inputCount ? record.in[column] : record.out[column - Maths::inputCount];
+    }
+}
+
+int Pareto::columnOf(Maths& maths, const std::string& letter) {
+    for (int i = 0; i < Maths::inputCount; i++) {
+        if (maths.mathInput[i + 1].inputLetter == letter) return i;
+    }
+    for (int o = 0; o < Maths::outputCount; o++) {
+        if (maths.mathOutput[o + 1].outputLetter == letter) return Maths::inputCount + o;
+    }
+    return -1;
+}
+
+std::string Pareto::columnName(Maths& maths, int column) {
+    return column < Maths::inputCount ? maths.mathInput[column + 1].inputLetter
+        : maths.mathOutput[column - Maths::inputCount + 1].outputLetter;
+}
+
+bool Pareto::parseObjectives(Maths& maths, const std::string& text) {
+    objectives.clear();
+    std::istringstream tokens(text);
+    std::string token;
+    while (tokens >> token) {
+        char direction = token.back();
+        int column = columnOf(maths, token.substr(0, token.size() - 1));
+        if ((direction != '+' && direction != '-') || column < 0) {
+            objectives.clear();
+            return false;
+        }
+        objectives.push_back(ParetoObjective{ column, direction == '+' });
+    }
+    return !objectives.empty();
+}
+
+bool Pareto::parseConstraints(Maths& maths, const std::string& text) {
+    constraints.clear();
+    std::istringstream tokens(text);
+    std::string token;
+    while (tokens >> token) {
+        if (token == "none") continue;
+        size_t at = token.find_first_of("<>");
+        if (at == std::string::npos || at + 2 >= token.size() || token[at + 1] != '=') {
+            constraints.clear();
+            return false;
+        }
+        int column = columnOf(maths, token.substr(0, at));
+        double limit = 0.0;
+        try {
+            limit = std::stod(token.substr(at + 2));
+        }
+        catch (...) {
+            column = -1;
+        }
+        if (column < 0) {
+            constraints.clear();
+            return false;
+        }
+        ParetoConstraint constraint;
+        constraint.column = column;
+        if (token[at] == '<') constraint.max = limit;
+        else constraint.min = limit;
+        constraints.push_back(constraint);
+    }
+    return true;
+}
+
+ParetoFront Pareto::frontOf(const DesignBatch& batch, std::size_t begin, std::size_t end) const {
+    const std::size_t m = objectives.size();
+    std::vector<SweepRecord> records;
+    std::vector<double> keys;
+    std::uint64_t considered = 0;
+
+    for (std::size_t r = begin; r < end; r++) {
+        if (!batch.mask.empty() && batch.mask[r] != 0) continue;
+
+        SweepRecord record;
+        for (int i = 0; i < Maths::inputCount; i++) record.in[i] = batch.in[i][r];
+        for (int o = 0; o < Maths::outputCount; o++) record.out[o] = batch.out[o][r];
+
+        bool fits = true;
+        for (const ParetoConstraint& c : constraints) {
+            double value = columnValue(record, c.column);
+            fits = fits && value >= c.min && value <= c.max;
+        }
+        if (!fits) continue;
+
+        considered++;
+        records.push_back(record);
+        for (const ParetoObjective& objective : objectives) {
+            double value = columnValue(record, objective.column);
+            keys.push_back(objective.maximize ? -value : value);
+        }
+    }
+    return skyline(records, keys, m, considered);
+}
+
+ParetoFront Pareto::merge(const ParetoFront& a, const ParetoFront& b) const {
+    std::vector<SweepRecord> records(a.records);
+    records.insert(records.end(), b.records.begin(), b.records.end());
+    std::vector<double> keys(a.keys);
+    keys.insert(keys.end(), b.keys.begin(), b.keys.end());
+    return skyline(records, keys, objectives.size(), a.considered + b.considered);
+}
+
+bool Pareto::extractFile(Maths& maths, const std::string& sweepPath, const std::string& outPath, std::ostream& report) const {
+    std::ifstream sweepFile(sweepPath, std::ios::binary);
+    if (!sweepFile.is_open()) {
+        report << "Error: couldn't open " << sweepPath << ".\n";
+        return false;
+    }
+    if (objectives.empty()) {
+        report << "No objectives chosen.\n";
+        return false;
+    }
+
+    std::size_t threadCount = threads > 0 ? static_cast<std::size_t>(threads) : std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    DesignBatch batch;
+    Validation validation;
+    ParetoFront result;
+    std::uint64_t total = 0;
+    std::size_t rows;
+    while ((rows = Sweep::readChunk(sweepFile, batch, 1 << 18)) > 0) {
+        validation.validate(batch);
+        total += rows;
+
+        // Divide: one block of rows per thread, each reduced to its own front.
+        std::vector<ParetoFront> parts(threadCount);
+        std::vector<std::thread> pool;
+        for (std::size_t t = 0; t < threadCount; t++) {
+            pool.emplace_back([&, t]() {
+                parts[t] = frontOf(batch, rows * t / threadCount, rows * (t + 1) / threadCount);
+            });
+        }
+        for (auto& thread : pool) thread.join();
+
+        // Conquer: merge neighbouring fronts pairwise, each pair on its own thread, until one is left.
+        while (parts.size() > 1) {
+            std::vector<ParetoFront> merged((parts.size() + 1) / 2);
+            pool.clear();
+            for (std::size_t p = 0; p < merged.size(); p++) {
+                pool.emplace_back([&, p]() {
+                    merged[p] = (2 * p + 1 < parts.size()) ? merge(parts[2 * p], parts[2 * p + 1]) : parts[2 * p];
+                });
+            }
+            for (auto& thread : pool) thread.join();
+            parts.swap(merged);
+        }
+        result = merge(result, parts[0]);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Write the front sorted by the first objective, best first.
+    const std::size_t m = objectives.size();
+    std::vector<std::size_t> order(result.records.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return result.keys[a * m] < result.keys[b * m];
+    });
+
+    std::ofstream outFile(outPath);
+    if (!outFile.is_open()) {
+        report << "Error: couldn't open " << outPath << " for writing.\n";
+        return false;
+    }
+    outFile << "# Pareto front of " << sweepPath << ": " << result.records.size() << " designs\n# Objectives:";
+    for (const ParetoObjective& objective : objectives) {
+        outFile << " " << columnName(maths, objective.column) << (objective.maximize ? "+" : "-");
+    }
+    outFile << "\n# Constraints:";
+    for (const ParetoConstraint& c : constraints) {
+        outFile << " " << columnName(maths, c.column) << (c.max != HUGE_VAL ? "<=" : ">=") << (c.max != HUGE_VAL ? c.max : c.min);
+    }
+    outFile << "\n";
+    for (int column = 0; column < Maths::inputCount + Maths::outputCount; column++) {
+        outFile << (column > 0 ? " " : "") << columnName(maths, column);
+    }
+    outFile << "\n";
+    for (std::size_t r : order) {
+        for (int column = 0; column < Maths::inputCount + Maths::outputCount; column++) {
+            outFile << (column > 0 ? " " : "") << columnValue(result.records[r], column);
+        }
+        outFile << "\n";
+    }
+
+    report << "Designs read: " << total << ", valid and within constraints: " << result.considered << "\n"
+        << "Pareto front: " << result.records.size() << " designs written to " << outPath << "\n"
+        << "Time: " << seconds << " s\n";
+    return true;
+}
@@ -0,0 +1,83 @@
+﻿/*
+ * File: pareto.h
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Declares `Pareto`, which finds the designs in a sweep that no other design beats on every chosen objective
+ *   (the non‐dominated / Pareto front), e.g. maximum Travel Margin, minimum Port Height and minimum Combination
+ *   Lever Length, among designs that fit the given constraints.
+ *   - `parseObjectives()` : "TM+ PH- CLL-" → maximize TM, minimize PH, minimize CLL
+ *   - `parseConstraints()`: "D<=72 B<=22 TM>=0.5" → limits on any input or output
+ *   - `extractFile()`     : stream a sweep file, compute the front, write it as text
+ *
+ * Developer Notes:
+ *  - Each chunk of the file is split across threads; every thread keeps only its own part's front, then the fronts
+ *    are merged pairwise (also in parallel) and into the running result. Only fronts are ever kept in memory,
+ *    never the whole sweep, so file size isn't limited by RAM.
+ *  - Fronts are found with sort‐filter‐skyline: sort by the sum of the objectives, then a point only has to be
+ *    checked against points already kept, since nothing later in that order can dominate it.
+ *  - Designs flagged by Validation (bad inputs/outputs) are left out.
+ *  - Designs with exactly the same objective values count as one trade‐off: only the first one found is kept.
+ */
+
+#ifndef PARETO_H
+#define PARETO_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "maths.h"
+#include "batch.h"
+#include "sweep.h"
+
+// One objective: a column of SweepRecord (0..6 inputs, 7..15 outputs) and which way is better.
+struct ParetoObjective {
+    int column = 0;
+    bool maximize = false;
+};
+
+// Only designs with min <= column <= max are considered.
+struct ParetoConstraint {
+    int column = 0;
+    double min = -HUGE_VAL;
+    double max = HUGE_VAL;
+};
+
+// A set of mutually non‐dominated designs. keys holds objectives.size() values per record, all "smaller is better".
+struct ParetoFront {
+    std::vector<SweepRecord> records;
+    std::vector<double> keys;
+    std::uint64_t considered = 0;   // valid rows within the constraints that went into this front
+};
+
+class Pareto {
+public:
+    std::vector<ParetoObjective> objectives;
+    std::vector<ParetoConstraint> constraints;
+    int threads = 0;                           // 0 = every hardware thread
+
+    // Column (0..15) of an input or output letter such as "D" or "CLL"; -1 if there is none.
+    static int columnOf(Maths& maths, const std::string& letter);
+    static std::string columnName(Maths& maths, int column);
+
+    // Parse space‐separated objectives/constraints. Returns false (and leaves the list empty) on a bad token.
+    bool parseObjectives(Maths& maths, const std::string& text);
+    bool parseConstraints(Maths& maths, const std::string& text);
+
+    // Compute the front of every design in sweepPath and write it to outPath. Prints a summary to report.
+    bool extractFile(Maths& maths, const std::string& sweepPath, const std::string& outPath, std::ostream& report) const;
+
+    // Front of batch rows [begin, end) that meet the constraints and have no Validation errors (batch.mask).
+    ParetoFront frontOf(const DesignBatch& batch, std::size_t begin, std::size_t end) const;
+
+    // Front of the union of two fronts.
+    ParetoFront merge(const ParetoFront& a, const ParetoFront& b) const;
+};
+
+#endif // PARETO_H
@@ -0,0 +1,139 @@
+﻿/*
+ * File: sensitivity.cpp
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Implements `Sensitivity`:
+ *   - evaluate(): seed each of the 7 inputs as a dual number and run Maths::formulas() once.
+ *   - elasticity(): scale a Jacobian entry by input/output to get a unit‐free sensitivity.
+ *   - evaluateBatch(): same as evaluate() but on Dual<Lanes<4>>, so 4 designs go through each pass.
+ *   - evaluateFile(): streams a sweep file through evaluateBatch() in chunks.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "sensitivity.h"
+#include "sweep.h"
+#include "maths.h"
+
+void Sensitivity::evaluate(Maths& maths) {
+    using D = Dual<double, Maths::inputCount>;
+    D in[Maths::inputCount];
+    D out[Maths::outputCount];
+
+    for (int i = 0; i < Maths::inputCount; i++) {
+        in[i] = D::variable(maths.mathInput[i + 1].input, i);
+    }
+
+    Maths::formulas(in, out);
+
+    for (int o = 0; o < Maths::outputCount; o++) {
+        value[o] = out[o].value;
+        for (int i = 0; i < Maths::inputCount; i++) {
+            jacobian[o][i] = out[o].grad[i];
+        }
+    }
+}
+
+double Sensitivity::elasticity(Maths& maths, int o, int i) const {
+    if (value[o] == 0.0) {
+        return 0.0;
+    }
+    return jacobian[o][i] * maths.mathInput[i + 1].input / value[o];
+}
+
+void Sensitivity::evaluateBatch(const DesignBatch& batch, SensitivityBatch& result) {
+    using L = Lanes<laneWidth>;
+    using D = Dual<L, Maths::inputCount>;
+    const std::size_t rows = batch.size();
+
+    for (int o = 0; o < Maths::outputCount; o++) {
+        result.value[o].resize(rows);
+        for (int i = 0; i < Maths::inputCount; i++) {
+            result.jacobian[o][i].resize(rows);
+        }
+    }
+
+    for (std::size_t start = 0; start < rows; start += laneWidth) {
+        // The last pass may be short; unused lanes repeat the last row so they stay finite.
+        const int used = static_cast<int>(rows - start < laneWidth ? rows - start : laneWidth);
+
+        D in[Maths::inputCount];
+        D out[Maths::outputCount];
+        for (int i = 0; i < Maths::inputCount; i++) {
+            L x;
+            for (int lane = 0; lane < laneWidth; lane++) {
+                x.v[lane] = batch.in[i][start + (lane < used ? lane : used - 1)];
+            }
+            in[i] = D::variable(x, i);
+        }
+
+        Maths::formulas(in, out);
+
+        for (int o = 0; o < Maths::outputCount; o++) {
+            for (int lane = 0; lane < used; lane++) {
+                result.value[o][start + lane] = out[o].value.v[lane];
+            }
+            for (int i = 0; i < Maths::inputCount; i++) {
+                for (int lane = 0; lane < used; lane++) {
+                    result.jacobian[o][i][start + lane] = out[o].grad[i].v[lane];
+                }
+            }
+        }
+    }
+}
+
+bool Sensitivity::evaluateFile(const std::string& sweepPath, const std::string& outPath, std::ostream& report) {
+    std::ifstream sweepFile(sweepPath, std::ios::binary);
+    if (!sweepFile.is_open()) {
+        report << "Error: couldn't open " << sweepPath << ".\n";
+        return false;
+    }
+    std::ofstream outFile(outPath, std::ios::binary);
+    if (!outFile.is_open()) {
+        report << "Error: couldn't open " << outPath << " for writing.\n";
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    DesignBatch batch;
+    SensitivityBatch result;
+    std::vector<SensitivityRecord> records;
+    std::uint64_t designs = 0;
+    std::size_t rows;
+    while ((rows = Sweep::readChunk(sweepFile, batch, 16384)) > 0) {
+        evaluateBatch(batch, result);
+
+        // Columns back into one record per design.
+        records.resize(rows);
+        for (int o = 0; o < Maths::outputCount; o++) {
+            for (std::size_t r = 0; r < rows; r++) {
+                records[r].value[o] = result.value[o][r];
+            }
+            for (int i = 0; i < Maths::inputCount; i++) {
+                for (std::size_t r = 0; r < rows; r++) {
+                    records[r].jacobian[o][i] = result.jacobian[o][i][r];
+                }
+            }
+        }
+        outFile.write(reinterpret_cast<const char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(SensitivityRecord)));
+        designs += rows;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!outFile) {
+        report << "Error: couldn't write " << outPath << ".\n";
+        return false;
+    }
+    report << "Designs: " << designs << " written to " << outPath << "\n"
+        << "Time: " << seconds << " s\n";
+    return true;
+}
@@ -0,0 +1,164 @@
+﻿/*
+ * File: sensitivity.h
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Forward‐mode automatic differentiation of the valve‐gear formulas.
+ *   - `Lanes<W>`   : W doubles handled as one value (element‐wise math), used to run W designs side by side
+ *   - `Dual<T, N>` : a value plus its N partial derivatives, templated on the scalar type T (double or Lanes<W>)
+ *   - `Sensitivity`: evaluates Maths::formulas() on dual numbers, giving all 9 outputs and the full 9×7
+ *                    Jacobian (d output / d input) in one pass, for a single design or a whole DesignBatch.
+ *   - `evaluateFile()`: the same for every design in a sweep file, written to a file of SensitivityRecords.
+ *
+ * Developer Notes:
+ *  - Dual numbers give exact derivatives (no step size to pick), and one pass replaces the 8 runs
+ *    finite differencing would need (1 base + 7 nudged inputs).
+ */
+
+#ifndef SENSITIVITY_H
+#define SENSITIVITY_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cstddef>
+#include "maths.h"
+#include "batch.h"
+
+class commonFunctions;
+
+// W doubles processed together. Every operator is a plain loop over the lanes,
+// which compilers turn into SIMD instructions at -O2 and above.
+template <int W>
+struct Lanes {
+    double v[W];
+
+    Lanes() = default;
+    Lanes(double broadcast) {
+        for (int i = 0; i < W; i++) v[i] = broadcast;
+    }
+};
+
+template <int W> Lanes<W> operator+(const Lanes<W>& a, const Lanes<W>& b) { Lanes<W> r; for (int i = 0; i < W; i++) r.v[i] = a.v[i] + b.v[i]; return r; }
+template <int W> Lanes<W> operator-(const Lanes<W>& a, const Lanes<W>& b) { Lanes<W> r; for (int i = 0; i < W; i++) r.v[i] = a.v[i] - b.v[i]; return r; }
+template <int W> Lanes<W> operator*(const Lanes<W>& a, const Lanes<W>& b) { Lanes<W> r; for (int i = 0; i < W; i++) r.v[i] = a.v[i] * b.v[i]; return r; }
+template <int W> Lanes<W> operator/(const Lanes<W>& a, const Lanes<W>& b) { Lanes<W> r; for (int i = 0; i < W; i++) r.v[i] = a.v[i] / b.v[i]; return r; }
+template <int W> Lanes<W> operator*(const Lanes<W>& a, double s) { Lanes<W> r; for (int i = 0; i < W; i++) r.v[i] = a.v[i] * s; return r; }
+template <int W> Lanes<W> operator*(double s, const Lanes<W>& a) { Lanes<W> r; for (int i = 0; i < W; i++) r.v[i] = s * a.v[i]; return r; }
+template <int W> Lanes<W> operator/(const Lanes<W>& a, double s) { Lanes<W> r; for (int i = 0; i < W; i++) r.v[i] = a.v[i] / s; return r; }
+
+// A value and its partial derivatives with respect to N seeded inputs.
+template <typename T, int N>
+struct Dual {
+    T value;
+    T grad[N];
+
+    Dual() = default;
+
+    // Constant: derivative 0 in every direction.
+    Dual(const T& constant) : value(constant) {
+        for (int i = 0; i < N; i++) grad[i] = T(0.0);
+    }
+
+    // Independent variable number `which`: derivative 1 with respect to itself, 0 otherwise.
+    static Dual variable(const T& x, int which) {
+        Dual d(x);
+        d.grad[which] = T(1.0);
+        return d;
+    }
+};
+
+template <typename T, int N>
+Dual<T, N> operator+(const Dual<T, N>& a, const Dual<T, N>& b) {
+    Dual<T, N> r;
+    r.value = a.value + b.value;
+    for (int i = 0; i < N; i++) r.grad[i] = a.grad[i] + b.grad[i];
+    return r;
+}
+
+template <typename T, int N>
+Dual<T, N> operator-(const Dual<T, N>& a, const Dual<T, N>& b) {
+    Dual<T, N> r;
+    r.value = a.value - b.value;
+    for (int i = 0; i < N; i++) r.grad[i] = a.grad[i] - b.grad[i];
+    return r;
+}
+
+// (ab)' = a'b + ab'
+template <typename T, int N>
+Dual<T, N> operator*(const Dual<T, N>& a, const Dual<T, N>& b) {
+    Dual<T, N> r;
+    r.value = a.value * b.value;
+    for (int i = 0; i < N; i++) r.grad[i] = a.grad[i] * b.value + a.value * b.grad[i];
+    return r;
+}
+
+// (a/b)' = (a' - (a/b)b') / b
+template <typename T, int N>
+Dual<T, N> operator/(const Dual<T, N>& a, const Dual<T, N>& b) {
+    Dual<T, N> r;
+    r.value = a.value / b.value;
+    for (int i = 0; i < N; i++) r.grad[i] = (a.grad[i] - r.value * b.grad[i]) / b.value;
+    return r;
+}
+
+// Scaling by a plain constant (the 336, 60, 12, π ... in the formulas).
+template <typename T, int N>
+Dual<T, N> operator*(const Dual<T, N>& a, double s) {
+    Dual<T, N> r;
+    r.value = a.value * s;
+    for (int i = 0; i < N; i++) r.grad[i] = a.grad[i] * s;
+    return r;
+}
+
+template <typename T, int N>
+Dual<T, N> operator*(double s, const Dual<T, N>& a) {
+    return a * s;
+}
+
+template <typename T, int N>
+Dual<T, N> operator/(const Dual<T, N>& a, double s) {
+    Dual<T, N> r;
+    r.value = a.value / s;
+    for (int i = 0; i < N; i++) r.grad[i] = a.grad[i] / s;
+    return r;
+}
+
+// Batched results: value[o][row] and jacobian[o][i][row] = d out[o] / d in[i] for that row.
+struct SensitivityBatch {
+    std::vector<double> value[Maths::outputCount];
+    std::vector<double> jacobian[Maths::outputCount][Maths::inputCount];
+};
+
+// One row of the file evaluateFile() writes, in the same order as the designs in the sweep file.
+struct SensitivityRecord {
+    double value[Maths::outputCount];
+    double jacobian[Maths::outputCount][Maths::inputCount];
+};
+
+class Sensitivity {
+public:
+    // Designs evaluated together per pass in evaluateBatch().
+    static constexpr int laneWidth = 4;
+
+    double value[Maths::outputCount] = {};                      // same numbers theActualMath() produces
+    double jacobian[Maths::outputCount][Maths::inputCount] = {}; // jacobian[o][i] = d out[o] / d in[i]
+
+    // Differentiate the formulas at the current mathInput values of maths.
+    void evaluate(Maths& maths);
+
+    // Relative sensitivity (d out / out) / (d in / in): the % change in output o per 1% change in input i.
+    // Lets inputs with different magnitudes be compared; 0 when the output itself is 0.
+    double elasticity(Maths& maths, int o, int i) const;
+
+    // Differentiate every row of batch, laneWidth rows per pass. Fills result.value and result.jacobian.
+    static void evaluateBatch(const DesignBatch& batch, SensitivityBatch& result);
+
+    // Differentiate every record of a sweep file and write SensitivityRecords to outPath. Prints a summary to report.
+    static bool evaluateFile(const std::string& sweepPath, const std::string& outPath, std::ostream& report);
+};
+
+#endif // SENSITIVITY_H
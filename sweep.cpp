@@ -0,0 +1,398 @@
+﻿/*
+ * File: sweep.cpp
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Implements `Sweep`:
+ *   - takeRanges(): prompts for from/to/steps per input.
+ *   - designAt(): mixed‐radix decode of a grid index (input D varies fastest).
+ *   - readChunk(): reads records back and spreads them into DesignBatch columns.
+ *   - run(): coordinator/worker sweep.
+ *       1. Find the CPUs we may use and which NUMA node each belongs to (/sys/devices/system/node).
+ *       2. Per worker, create a ring in POSIX shared memory (shm_open + mmap, unlinked right away so nothing
+ *          is left behind if we crash).
+ *       3. fork() the workers; each pins itself to its CPU, evaluates its shard and pushes records into its ring.
+ *       4. The output file is sized for the whole grid, then the coordinator drains the rings round‐robin with
+ *          pwrite() straight from the shared pages to each record's grid position, watches for crashed workers,
+ *          then reports designs/second per NUMA node.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <fstream>
+#include <thread>
+#include "sweep.h"
+#include "common.h"
+#include "maths.h"
+
+#ifdef __linux__
+#include <sched.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#endif
+
+bool Sweep::takeRanges(commonFunctions& common, Maths& maths) {
+    std::string input2;
+    for (int i = 0; i < Maths::inputCount; i++) {
+        auto& lookfor = maths.mathInput[i + 1];
+        std::cout << "[" << lookfor.inputLetter << "] " << lookfor.inputName << ": from, to, steps\n"
+            << "Example: [" << lookfor.inputExample << " " << lookfor.inputExample << " 1]\n";
+        std::cin >> range[i].from >> range[i].to >> range[i].steps;
+        if (std::cin.fail() || range[i].steps < 1) {
+            common.handlingBadInput();
+            std::cout << "Range for [" << lookfor.inputName << "] is invalid."
+                << "\nEnter anything to continue.\n> ";
+            std::cin >> input2;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint64_t Sweep::totalDesigns() const {
+    std::uint64_t total = 1;
+    for (const auto& r : range) {
+        total *= static_cast<std::uint64_t>(r.steps);
+    }
+    return total;
+}
+
+void Sweep::designAt(std::uint64_t index, double* inputs) const {
+    for (int i = 0; i < Maths::inputCount; i++) {
+        const SweepRange& r = range[i];
+        std::uint64_t k = index % static_cast<std::uint64_t>(r.steps);
+        index /= static_cast<std::uint64_t>(r.steps);
+        inputs[i] = (r.steps == 1) ? r.from : r.from + (r.to - r.from) * static_cast<double>(k) / (r.steps - 1);
+    }
+}
+
+std::size_t Sweep::readChunk(std::ifstream& file, DesignBatch& batch, std::size_t maxRows) {
+    std::vector<SweepRecord> records(maxRows);
+    file.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(maxRows * sizeof(SweepRecord)));
+    std::size_t rows = static_cast<std::size_t>(file.gcount()) / sizeof(SweepRecord);
+
+    batch.resize(rows);
+    for (std::size_t r = 0; r < rows; r++) {
+        for (int i = 0; i < Maths::inputCount; i++) batch.in[i][r] = records[r].in[i];
+        for (int o = 0; o < Maths::outputCount; o++) batch.out[o][r] = records[r].out[o];
+    }
+    return rows;
+}
+
+#ifdef __linux__
+namespace {
+    // Shared between one worker (producer) and the coordinator (consumer). The slots follow the header.
+    // head and tail sit on separate cache lines so the two sides don't keep stealing each other's line.
+    struct SweepRing {
+        alignas(64) std::atomic<std::uint64_t> head{ 0 };   // records published by the worker
+        alignas(64) std::atomic<std::uint64_t> tail{ 0 };   // records written to disk by the coordinator
+        alignas(64) std::atomic<std::uint32_t> finished{ 0 };
+        std::uint64_t elapsedNs = 0;                        // worker's own run time, valid once finished
+    };
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "ring counters must be lock-free to live in shared memory");
+
+    struct Worker {
+        pid_t pid = -1;
+        int cpu = 0;
+        int node = 0;
+        std::uint64_t begin = 0;
+        std::uint64_t end = 0;
+        SweepRing* ring = nullptr;
+        SweepRecord* slots = nullptr;
+        size_t mappedBytes = 0;
+        bool drained = false;
+        bool crashed = false;
+    };
+
+    // Parse a kernel CPU list such as "0-3,8-11".
+    std::vector<int> parseCpuList(const std::string& list) {
+        std::vector<int> cpus;
+        size_t pos = 0;
+        while (pos < list.size()) {
+            size_t comma = list.find(',', pos);
+            std::string part = list.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+            size_t dash = part.find('-');
+            try {
+                int first = std::stoi(part);
+                int last = (dash == std::string::npos) ? first : std::stoi(part.substr(dash + 1));
+                for (int c = first; c <= last; c++) cpus.push_back(c);
+            }
+            catch (...) {
+                // Skip anything that isn't a number (e.g. the trailing newline).
+            }
+            if (comma == std::string::npos) break;
+            pos = comma + 1;
+        }
+        return cpus;
+    }
+
+    // CPUs we're allowed to run on, grouped by NUMA node. Machines without NUMA info count as one node.
+    std::vector<std::vector<int>> cpusByNode() {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        sched_getaffinity(0, sizeof(allowed), &allowed);
+
+        std::vector<std::vector<int>> nodes;
+        for (int node = 0; ; node++) {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!file.is_open()) break;
+            std::string list;
+            std::getline(file, list);
+            std::vector<int> usable;
+            for (int cpu : parseCpuList(list)) {
+                if (CPU_ISSET(cpu, &allowed)) usable.push_back(cpu);
+            }
+            nodes.push_back(usable);
+        }
+
+        bool anyCpu = false;
+        for (const auto& node : nodes) anyCpu = anyCpu || !node.empty();
+        if (!anyCpu) {
+            nodes.assign(1, {});
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &allowed)) nodes[0].push_back(cpu);
+            }
+        }
+        return nodes;
+    }
+
+    // Body of a forked worker: pin, evaluate the shard, publish into the ring. Never returns.
+    [[noreturn]] void runWorker(const Sweep& sweep, Worker& worker, std::uint64_t capacity, pid_t coordinator) {
+        // If the coordinator dies nothing will drain the ring again, so go with it instead of spinning on a full
+        // ring forever. The getppid() check covers a coordinator that died before prctl() took effect.
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (getppid() != coordinator) _exit(1);
+
+        cpu_set_t only;
+        CPU_ZERO(&only);
+        CPU_SET(worker.cpu, &only);
+        sched_setaffinity(0, sizeof(only), &only);
+
+        auto start = std::chrono::steady_clock::now();
+        SweepRing& ring = *worker.ring;
+        std::uint64_t head = 0;
+        std::uint64_t tail = 0; // last tail we saw; only re‐read when the ring looks full
+        const std::uint64_t count = worker.end - worker.begin;
+
+        for (std::uint64_t n = 0; n < count; n++) {
+            while (head - tail == capacity) {
+                tail = ring.tail.load(std::memory_order_acquire);
+                if (head - tail == capacity) sched_yield();
+            }
+            // Records are built in place, in the shared page the coordinator will write out.
+            SweepRecord& record = worker.slots[head % capacity];
+            sweep.designAt(worker.begin + n, record.in);
+            Maths::formulas(record.in, record.out);
+            head++;
+            // Publish in groups so the coordinator's cache line isn't bounced on every record.
+            if ((head & 63) == 0) ring.head.store(head, std::memory_order_release);
+        }
+        ring.head.store(head, std::memory_order_release);
+
+        ring.elapsedNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        ring.finished.store(1, std::memory_order_release);
+        _exit(0);
+    }
+
+    // pwrite() the whole span at offset, retrying on partial writes.
+    bool writeAllAt(int fd, const char* data, size_t bytes, off_t offset) {
+        while (bytes > 0) {
+            ssize_t written = pwrite(fd, data, bytes, offset);
+            if (written <= 0) return false;
+            data += written;
+            bytes -= static_cast<size_t>(written);
+            offset += written;
+        }
+        return true;
+    }
+
+    // Undo the shared memory mappings made so far.
+    void unmapRings(std::vector<Worker>& pool) {
+        for (Worker& worker : pool) {
+            if (worker.ring != nullptr) munmap(worker.ring, worker.mappedBytes);
+            worker.ring = nullptr;
+        }
+    }
+}
+
+SweepStatus Sweep::run(const std::string& path, std::ostream& report) const {
+    const std::uint64_t total = totalDesigns();
+    const std::uint64_t capacity = static_cast<std::uint64_t>(ringCapacity > 0 ? ringCapacity : 4096);
+
+    std::vector<std::vector<int>> nodes = cpusByNode();
+    size_t cpuCount = 0;
+    for (const auto& node : nodes) cpuCount += node.size();
+    if (cpuCount == 0) cpuCount = 1;
+
+    size_t workerCount = workers > 0 ? static_cast<size_t>(workers) : cpuCount;
+    if (workerCount > cpuCount * maxWorkersPerCpu) {
+        workerCount = cpuCount * maxWorkersPerCpu;
+        report << "Using " << workerCount << " workers (at most " << maxWorkersPerCpu << " per CPU).\n";
+    }
+    if (workerCount > total) workerCount = static_cast<size_t>(total > 0 ? total : 1);
+
+    // Shards are contiguous index ranges, workers are spread across nodes round‐robin.
+    std::vector<Worker> pool(workerCount);
+    for (size_t w = 0; w < workerCount; w++) {
+        Worker& worker = pool[w];
+        worker.begin = total * w / workerCount;
+        worker.end = total * (w + 1) / workerCount;
+
+        size_t node = w % nodes.size();
+        while (nodes[node].empty()) node = (node + 1) % nodes.size();
+        worker.node = static_cast<int>(node);
+        worker.cpu = nodes[node].empty() ? 0 : nodes[node][(w / nodes.size()) % nodes[node].size()];
+
+        std::string name = "/vgc-sweep-" + std::to_string(getpid()) + "-" + std::to_string(w);
+        int shm = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (shm < 0) {
+            report << "Error: couldn't create shared memory for worker " << w << ".\n";
+            unmapRings(pool);
+            return SweepStatus::notStarted;
+        }
+        worker.mappedBytes = sizeof(SweepRing) + capacity * sizeof(SweepRecord);
+        void* memory = MAP_FAILED;
+        if (ftruncate(shm, static_cast<off_t>(worker.mappedBytes)) == 0) {
+            memory = mmap(nullptr, worker.mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, shm, 0);
+        }
+        close(shm);
+        shm_unlink(name.c_str());
+        if (memory == MAP_FAILED) {
+            report << "Error: couldn't map shared memory for worker " << w << ".\n";
+            unmapRings(pool);
+            return SweepStatus::notStarted;
+        }
+        // Only the header page is touched here; slot pages get first‐touched by the pinned worker,
+        // so the kernel places them on that worker's NUMA node.
+        worker.ring = new (memory) SweepRing();
+        worker.slots = reinterpret_cast<SweepRecord*>(static_cast<char*>(memory) + sizeof(SweepRing));
+    }
+
+    // Opened only now, so a failed setup leaves any previous sweep file as it was. Sizing it for the whole grid
+    // lets every worker's records go straight to their own place in it.
+    int outFd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (outFd < 0 || ftruncate(outFd, static_cast<off_t>(total * sizeof(SweepRecord))) != 0) {
+        report << "Error: couldn't open " << path << " for writing.\n";
+        if (outFd >= 0) close(outFd);
+        unmapRings(pool);
+        return SweepStatus::notStarted;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::cout << std::flush; // don't let children inherit (and repeat) buffered output
+    const pid_t coordinator = getpid();
+    for (Worker& worker : pool) {
+        worker.pid = fork();
+        if (worker.pid == 0) {
+            runWorker(*this, worker, capacity, coordinator);
+        }
+        if (worker.pid < 0) {
+            worker.crashed = true;
+            worker.drained = true;
+        }
+    }
+
+    bool ok = true;
+    size_t active = 0;
+    for (const Worker& worker : pool) active += worker.drained ? 0 : 1;
+
+    while (active > 0) {
+        bool progress = false;
+        for (Worker& worker : pool) {
+            if (worker.drained) continue;
+            // Read `finished` before `head`: if it was already set, this head is the final one.
+            bool finished = worker.ring->finished.load(std::memory_order_acquire) != 0;
+            std::uint64_t head = worker.ring->head.load(std::memory_order_acquire);
+            std::uint64_t tail = worker.ring->tail.load(std::memory_order_relaxed);
+            if (head > tail) {
+                // Largest span that doesn't wrap, written straight from the shared slots to its grid position.
+                std::uint64_t first = tail % capacity;
+                std::uint64_t span = head - tail;
+                if (span > capacity - first) span = capacity - first;
+                if (!writeAllAt(outFd, reinterpret_cast<const char*>(worker.slots + first), span * sizeof(SweepRecord),
+                    static_cast<off_t>((worker.begin + tail) * sizeof(SweepRecord)))) {
+                    report << "Error: writing " << path << " failed.\n";
+                    for (Worker& other : pool) {
+                        if (other.pid > 0 && !other.drained) kill(other.pid, SIGKILL);
+                    }
+                    ok = false;
+                    active = 0;
+                    break;
+                }
+                worker.ring->tail.store(tail + span, std::memory_order_release);
+                progress = true;
+            }
+            else if (finished || worker.crashed) {
+                worker.drained = true;
+                active--;
+            }
+        }
+        if (!ok) break;
+
+        if (!progress) {
+            // Nothing to write; check for workers that died without finishing.
+            int status = 0;
+            pid_t pid = waitpid(-1, &status, WNOHANG);
+            for (Worker& worker : pool) {
+                if (pid > 0 && worker.pid == pid && !worker.ring->finished.load(std::memory_order_acquire)) {
+                    worker.crashed = true;
+                }
+            }
+            // Sleep rather than spin: by default every CPU has a pinned worker, and a ring holds a few ms of
+            // records, so a short nap costs nothing while polling would take time from one of them.
+            if (pid <= 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    close(outFd);
+
+    // Reap everyone that's left.
+    for (const Worker& worker : pool) {
+        if (worker.pid > 0) waitpid(worker.pid, nullptr, 0);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::uint64_t written = 0;
+    std::vector<double> nodeRate(nodes.size(), 0.0);
+    std::vector<int> nodeWorkers(nodes.size(), 0);
+    for (const Worker& worker : pool) {
+        std::uint64_t done = worker.ring->tail.load(std::memory_order_acquire);
+        written += done;
+        if (worker.crashed) {
+            ok = false;
+            report << "Worker " << worker.pid << " (designs " << worker.begin << "-" << worker.end - 1
+                << ") stopped early; " << (worker.end - worker.begin - done) << " designs missing (left as zeros).\n";
+        }
+        else if (worker.ring->elapsedNs > 0) {
+            nodeRate[worker.node] += static_cast<double>(done) * 1e9 / static_cast<double>(worker.ring->elapsedNs);
+        }
+        nodeWorkers[worker.node]++;
+    }
+    unmapRings(pool);
+
+    report << "Designs written: " << written << " of " << total << " to " << path << "\n"
+        << "Time: " << seconds << " s (" << (seconds > 0 ? written / seconds : 0.0) << " designs/s overall)\n";
+    for (size_t node = 0; node < nodes.size(); node++) {
+        if (nodeWorkers[node] == 0) continue;
+        report << "NUMA node " << node << ": " << nodeWorkers[node] << " workers, "
+            << nodeRate[node] << " designs/s\n";
+    }
+    return ok ? SweepStatus::complete : SweepStatus::incomplete;
+}
+#else
+SweepStatus Sweep::run(const std::string& path, std::ostream& report) const {
+    report << "Sweeps fork worker processes and are only available on Linux for now.\n";
+    return SweepStatus::notStarted;
+}
+#endif
@@ -0,0 +1,87 @@
+﻿/*
+ * File: sweep.h
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Declares `Sweep`, which evaluates every design on a grid of input values using several worker processes.
+ *   - `takeRanges()`: Prompt for a from/to/steps range per input (D, S, B, L, A, T, W).
+ *   - `designAt()`  : Turn a grid index (0 .. totalDesigns()-1) into the 7 input values.
+ *   - `run()`       : Coordinator. Splits the grid into one contiguous shard per worker, forks workers pinned to
+ *                     CPUs (spread over NUMA nodes), and writes their results into a file of SweepRecords
+ *                     in grid order (record n is designAt(n)).
+ *   - `readChunk()` : Read the next block of SweepRecords from a sweep file into a DesignBatch.
+ *
+ * Developer Notes:
+ *  - Each worker owns a single‐producer/single‐consumer ring in POSIX shared memory. The coordinator writes
+ *    records to disk straight out of the ring, at their shard's offset in the file, so results are never copied
+ *    between worker and file and the file's order doesn't depend on which worker finished first.
+ *  - Workers are processes rather than threads so a crashing shard only loses its own remaining designs.
+ *    It works the other way too: workers are killed if the coordinator dies.
+ *  - Forking and CPU pinning are Linux‐only; other platforms get a message instead.
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <cstdint>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <cstddef>
+#include "maths.h"
+#include "batch.h"
+
+class commonFunctions;
+
+// One evaluated design, exactly as stored in the sweep file (16 doubles, 128 bytes).
+struct SweepRecord {
+    double in[Maths::inputCount];   // D, S, B, L, A, T, W
+    double out[Maths::outputCount]; // WS ... CLL
+};
+
+// Range of values one input takes in a sweep; steps == 1 keeps it fixed at `from`.
+struct SweepRange {
+    double from = 0.0;
+    double to = 0.0;
+    int steps = 1;
+};
+
+// What run() managed to do.
+enum class SweepStatus {
+    notStarted,   // setup failed; the sweep file was left as it was
+    incomplete,   // the file was written, but a shard stopped early or writing failed partway
+    complete
+};
+
+class Sweep {
+public:
+    SweepRange range[Maths::inputCount]; // one range per input, same order as mathInput[1..7]
+    int workers = 0;                     // worker processes; 0 = one per available CPU
+    static constexpr int maxWorkersPerCpu = 4; // more workers than this only adds context switches
+    int ringCapacity = 4096;             // records per worker ring
+
+    // Where run() writes its results by default.
+    static constexpr const char* defaultPath = "outputs/sweep.bin";
+
+    // Prompt the user for a range per input. Returns false if an entry was invalid.
+    bool takeRanges(commonFunctions& common, Maths& maths);
+
+    // Number of designs on the grid (product of all steps).
+    std::uint64_t totalDesigns() const;
+
+    // Fill inputs[0..6] with the design at grid position index.
+    void designAt(std::uint64_t index, double* inputs) const;
+
+    // Evaluate the whole grid and write SweepRecords to path, in grid order. Prints progress/throughput to report.
+    // A shard that fails leaves its missing designs as zeros, which Validation flags.
+    SweepStatus run(const std::string& path, std::ostream& report) const;
+
+    // Replace batch's rows with up to maxRows records read from file (opened in binary mode).
+    // Returns the number of rows read; 0 at the end of the file.
+    static std::size_t readChunk(std::ifstream& file, DesignBatch& batch, std::size_t maxRows);
+};
+
+#endif // SWEEP_H
@@ -0,0 +1,107 @@
+﻿/*
+ * File: validation.cpp
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Implements `Validation`.
+ *   - validate(): one pass per column, OR‐ing a rule bit into every row's mask. The comparisons are combined
+ *                 with & / | instead of if/&&, so there are no branches and the loops vectorize.
+ *   - validateFile(): streams a sweep file through validate() in chunks, so file size isn't limited by memory.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cfloat>
+#include <cstddef>
+#include "validation.h"
+#include "sweep.h"
+#include "maths.h"
+
+void Validation::validate(DesignBatch& batch) {
+    const std::size_t count = batch.size();
+    batch.mask.assign(count, 0);
+    std::uint32_t* mask = batch.mask.data();
+
+    // Inputs: bad when not (0 < x <= DBL_MAX). NaN fails both comparisons, ±inf fails one.
+    for (int i = 0; i < Maths::inputCount; i++) {
+        const double* x = batch.in[i].data();
+        const std::uint32_t bit = 1u << (firstInputRule + i);
+        for (std::size_t r = 0; r < count; r++) {
+            std::uint32_t good = static_cast<std::uint32_t>(x[r] > 0.0) & static_cast<std::uint32_t>(x[r] <= DBL_MAX);
+            mask[r] |= (good ^ 1u) * bit;
+        }
+    }
+
+    // Outputs: bad when not (y >= 0), which is true for negatives and NaN alike.
+    for (int o = 0; o < Maths::outputCount; o++) {
+        const double* y = batch.out[o].data();
+        const std::uint32_t bit = 1u << (firstOutputRule + o);
+        for (std::size_t r = 0; r < count; r++) {
+            mask[r] |= static_cast<std::uint32_t>(!(y[r] >= 0.0)) * bit;
+        }
+    }
+
+    // Lap + Lead == 0 makes the CLL denominator zero.
+    const double* lead = batch.in[3].data();
+    const double* lap = batch.in[4].data();
+    for (std::size_t r = 0; r < count; r++) {
+        mask[r] |= static_cast<std::uint32_t>(lap[r] + lead[r] == 0.0) << zeroLapLeadRule;
+    }
+
+    // Summary counts, again without branches.
+    rows += count;
+    for (std::size_t r = 0; r < count; r++) {
+        badRows += static_cast<std::uint64_t>(mask[r] != 0);
+    }
+    for (int rule = 0; rule < ruleCount; rule++) {
+        std::uint64_t hits = 0;
+        for (std::size_t r = 0; r < count; r++) {
+            hits += (mask[r] >> rule) & 1u;
+        }
+        failures[rule] += hits;
+    }
+}
+
+bool Validation::validateFile(const std::string& sweepPath, const std::string& maskPath, std::ostream& report) {
+    std::ifstream sweepFile(sweepPath, std::ios::binary);
+    if (!sweepFile.is_open()) {
+        report << "Error: couldn't open " << sweepPath << ".\n";
+        return false;
+    }
+    std::ofstream maskFile(maskPath, std::ios::binary);
+    if (!maskFile.is_open()) {
+        report << "Error: couldn't open " << maskPath << " for writing.\n";
+        return false;
+    }
+
+    DesignBatch batch;
+    while (Sweep::readChunk(sweepFile, batch, 65536) > 0) {
+        validate(batch);
+        maskFile.write(reinterpret_cast<const char*>(batch.mask.data()),
+            static_cast<std::streamsize>(batch.mask.size() * sizeof(std::uint32_t)));
+    }
+    return true;
+}
+
+std::string Validation::ruleName(Maths& maths, int rule) {
+    if (rule >= firstInputRule && rule < firstOutputRule) {
+        return "Input [" + maths.mathInput[rule - firstInputRule + 1].inputLetter + "] <= 0 or not finite";
+    }
+    if (rule >= firstOutputRule && rule < zeroLapLeadRule) {
+        return "Output [" + maths.mathOutput[rule - firstOutputRule + 1].outputLetter + "] negative or NaN";
+    }
+    return "Lap + Lead == 0 (CLL divides by zero)";
+}
+
+void Validation::printSummary(Maths& maths, std::ostream& out) const {
+    out << "Rows checked: " << rows << ", rows with errors: " << badRows << "\n";
+    for (int rule = 0; rule < ruleCount; rule++) {
+        if (failures[rule] > 0) {
+            out << " - " << ruleName(maths, rule) << ": " << failures[rule] << "\n";
+        }
+    }
+}
@@ -0,0 +1,53 @@
+﻿/*
+ * File: validation.h
+ * Copyright 2026 Valve Gear Calculator contributors
+ * Author: Valve Gear Calculator contributors (not written by Deaven Garcia)
+ * Created: 10/18/26
+ * Last Updated: 10/18/26
+ *
+ * Description:
+ *   Declares `Validation`, the batch version of the checks breakItDown() and visualMath() do one design at a time.
+ *   Instead of stopping at the first problem, every row gets a bitmask of every rule it breaks:
+ *   - bits 0..6  : input D, S, B, L, A, T, W is zero/negative or not a finite number
+ *   - bits 7..15 : output WS ... CLL is negative or NaN
+ *   - bit 16     : Lap + Lead == 0 (the Combination Lever Length formula divides by it)
+ *   - `validate()`    : fill batch.mask for every row and add to the per‐rule failure counts
+ *   - `validateFile()`: same for a whole sweep file, writing the masks next to it
+ *   - `printSummary()`: how many rows broke each rule
+ */
+
+#ifndef VALIDATION_H
+#define VALIDATION_H
+
+#include <cstdint>
+#include <string>
+#include <iostream>
+#include "maths.h"
+#include "batch.h"
+
+class Validation {
+public:
+    static constexpr int firstInputRule = 0;                              // + input index (0..6)
+    static constexpr int firstOutputRule = Maths::inputCount;             // + output index (0..8)
+    static constexpr int zeroLapLeadRule = Maths::inputCount + Maths::outputCount;
+    static constexpr int ruleCount = zeroLapLeadRule + 1;
+
+    std::uint64_t rows = 0;                  // rows checked so far
+    std::uint64_t badRows = 0;               // rows with at least one bit set
+    std::uint64_t failures[ruleCount] = {};  // rows that broke each rule
+
+    // Compute batch.mask (one entry per row) and add the results to the counters above.
+    void validate(DesignBatch& batch);
+
+    // Validate every record of a sweep file, writing one 32‐bit mask per record to maskPath.
+    // Returns false (and says why on report) if either file couldn't be opened.
+    bool validateFile(const std::string& sweepPath, const std::string& maskPath, std::ostream& report);
+
+    // Readable name of a rule bit, e.g. "Input [B] <= 0 or not finite".
+    static std::string ruleName(Maths& maths, int rule);
+
+    // Print rows checked, rows with errors, and the failure count of every rule that was hit.
+    void printSummary(Maths& maths, std::ostream& out) const;
+};
+
+#endif // VALIDATION_H